@@ -0,0 +1,86 @@
+/**
+ * @file adc_sampler.h
+ * @brief ADC sampling backends - ESP32 continuous (DMA) mode or a synthetic waveform
+ */
+
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+
+#include <Arduino.h>
+#include "effect_random.h"
+
+#ifdef ESP32
+#include <esp_adc_cal.h>
+#endif
+
+// Source of raw 12-bit samples for one pin. read() never blocks: it hands
+// out whatever has been captured since the last call.
+class ADCSampler {
+public:
+    virtual ~ADCSampler() {}
+    virtual bool begin(uint8_t pin, uint32_t sampleRateHz) = 0;
+    // Copy up to maxSamples new raw samples; returns how many were copied
+    virtual size_t read(uint16_t* raw, size_t maxSamples) = 0;
+    // Calibrated conversion - callers average raw samples first, then convert once
+    virtual uint32_t rawToMilliVolts(uint32_t raw) = 0;
+    // Samples lost because they were not read in time
+    virtual uint32_t getOverflowCount() { return 0; }
+};
+
+#ifdef ESP32
+// ADC1 in continuous mode: the digital controller samples at a fixed rate and
+// DMA fills the driver's ring buffer, so sampling costs no CPU time. ADC1
+// pins only (GPIO 32-39); the ESP32 runs it at 20 kHz or more.
+class ContinuousADCSampler : public ADCSampler {
+public:
+    bool begin(uint8_t pin, uint32_t sampleRateHz) override;
+    size_t read(uint16_t* raw, size_t maxSamples) override;
+    uint32_t rawToMilliVolts(uint32_t raw) override;
+    uint32_t getOverflowCount() override;
+
+private:
+    static const uint32_t DMA_BUFFER_BYTES = 4096;   // Driver ring buffer, ~100 ms at 20 kHz
+    static const uint32_t DMA_FRAME_BYTES = 256;     // Bytes per DMA interrupt
+
+    int8_t channel = -1;
+    bool running = false;
+    uint32_t overflowCount = 0;
+    esp_adc_cal_characteristics_t calibration;
+};
+#endif
+
+// Generated samples for host runs and bench tests: the pin's level
+// (analogReadMilliVolts, i.e. NativeHW on the host) plus a sine ripple,
+// uniform noise and occasional spikes, paced by micros().
+struct SyntheticWaveform {
+    uint16_t amplitudeMv = 0;     // Sine ripple peak
+    uint16_t periodMs = 1000;
+    uint16_t noiseMv = 0;         // Uniform noise, +-noiseMv
+    uint16_t spikeMv = 0;         // Added to a spiking sample (bubbles, EMI)
+    uint8_t spikeChance = 0;      // Per sample, out of 256
+};
+
+class SyntheticADCSampler : public ADCSampler {
+public:
+    static const uint32_t FULL_SCALE_MV = 3300;   // Raw 4095
+
+    void setWaveform(const SyntheticWaveform& newWaveform);
+    void seed(uint32_t value);
+
+    bool begin(uint8_t pin, uint32_t sampleRateHz) override;
+    size_t read(uint16_t* raw, size_t maxSamples) override;
+    uint32_t rawToMilliVolts(uint32_t raw) override;
+    uint32_t getOverflowCount() override;
+
+private:
+    uint8_t pin = 0;
+    uint32_t sampleRateHz = 0;
+    uint64_t sampleIndex = 0;     // Next sample to generate
+    uint64_t elapsedUs = 0;       // Since begin()
+    unsigned long lastUs = 0;
+    uint32_t overflowCount = 0;
+    SyntheticWaveform waveform;
+    EffectRandom rng;
+};
+
+#endif // ADC_SAMPLER_H
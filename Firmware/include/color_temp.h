@@ -0,0 +1,44 @@
+/**
+ * @file color_temp.h
+ * @brief Colour temperature to RGB lookup using the precomputed table
+ */
+
+#ifndef COLOR_TEMP_H
+#define COLOR_TEMP_H
+
+#include <stdint.h>
+#include "color_temp_table.h"
+
+struct ColorTempRGB {
+    uint8_t r, g, b;
+};
+
+// Interpolate between neighbouring table entries in 8.8 fixed point.
+// Temperatures outside the table range are clamped to the first/last entry.
+static inline ColorTempRGB colorTempLookup(float tempK) {
+    const uint8_t* lo;
+    const uint8_t* hi;
+    int frac;
+
+    if (tempK <= COLOR_TEMP_TABLE_MIN_K) {
+        lo = hi = COLOR_TEMP_TABLE[0];
+        frac = 0;
+    } else if (tempK >= COLOR_TEMP_TABLE_MAX_K) {
+        lo = hi = COLOR_TEMP_TABLE[COLOR_TEMP_TABLE_SIZE - 1];
+        frac = 0;
+    } else {
+        uint32_t pos = (uint32_t)((tempK - COLOR_TEMP_TABLE_MIN_K) * (256.0f / COLOR_TEMP_TABLE_STEP_K));
+        uint32_t idx = pos >> 8;
+        lo = COLOR_TEMP_TABLE[idx];
+        hi = COLOR_TEMP_TABLE[idx + 1];
+        frac = pos & 0xFF;
+    }
+
+    ColorTempRGB color;
+    color.r = lo[0] + ((hi[0] - lo[0]) * frac) / 256;
+    color.g = lo[1] + ((hi[1] - lo[1]) * frac) / 256;
+    color.b = lo[2] + ((hi[2] - lo[2]) * frac) / 256;
+    return color;
+}
+
+#endif // COLOR_TEMP_H
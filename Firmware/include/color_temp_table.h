@@ -0,0 +1,88 @@
+/**
+ * @file color_temp_table.h
+ * @brief Precomputed black body colour temperature to RGB table
+ *
+ * GENERATED by tools/gen_color_temp_table.py - do not edit by hand.
+ */
+
+#ifndef COLOR_TEMP_TABLE_H
+#define COLOR_TEMP_TABLE_H
+
+#include <stdint.h>
+
+#define COLOR_TEMP_TABLE_MIN_K 0
+#define COLOR_TEMP_TABLE_MAX_K 6500
+#define COLOR_TEMP_TABLE_STEP_K 100
+#define COLOR_TEMP_TABLE_SIZE 66
+
+// {r, g, b} per entry, const so it stays in flash (.rodata)
+static const uint8_t COLOR_TEMP_TABLE[COLOR_TEMP_TABLE_SIZE][3] = {
+    {  0,   0,   0}, //     0 K
+    {  0,   0,   0}, //   100 K
+    {  0,   0,   0}, //   200 K
+    {  0,   0,   0}, //   300 K
+    {  0,   0,   0}, //   400 K
+    {255,   0,   0}, //   500 K
+    {255,   5,   0}, //   600 K
+    {255,  10,   0}, //   700 K
+    {255,  16,   0}, //   800 K
+    {255,  23,   1}, //   900 K
+    {255,  32,   2}, //  1000 K
+    {255,  40,   4}, //  1100 K
+    {255,  49,   6}, //  1200 K
+    {255,  59,   9}, //  1300 K
+    {255,  68,  13}, //  1400 K
+    {255,  77,  17}, //  1500 K
+    {255,  86,  21}, //  1600 K
+    {255,  95,  26}, //  1700 K
+    {255, 103,  32}, //  1800 K
+    {255, 111,  38}, //  1900 K
+    {255, 120,  44}, //  2000 K
+    {255, 127,  50}, //  2100 K
+    {255, 135,  57}, //  2200 K
+    {255, 142,  63}, //  2300 K
+    {255, 149,  70}, //  2400 K
+    {255, 156,  77}, //  2500 K
+    {255, 162,  84}, //  2600 K
+    {255, 168,  91}, //  2700 K
+    {255, 174,  99}, //  2800 K
+    {255, 180, 106}, //  2900 K
+    {255, 186, 113}, //  3000 K
+    {255, 191, 120}, //  3100 K
+    {255, 196, 127}, //  3200 K
+    {255, 201, 134}, //  3300 K
+    {255, 206, 141}, //  3400 K
+    {255, 210, 148}, //  3500 K
+    {255, 215, 155}, //  3600 K
+    {255, 219, 161}, //  3700 K
+    {255, 223, 168}, //  3800 K
+    {255, 227, 174}, //  3900 K
+    {255, 231, 181}, //  4000 K
+    {255, 235, 187}, //  4100 K
+    {255, 238, 193}, //  4200 K
+    {255, 242, 199}, //  4300 K
+    {255, 245, 205}, //  4400 K
+    {255, 248, 211}, //  4500 K
+    {255, 251, 217}, //  4600 K
+    {255, 254, 223}, //  4700 K
+    {252, 255, 226}, //  4800 K
+    {249, 255, 229}, //  4900 K
+    {246, 255, 231}, //  5000 K
+    {244, 255, 234}, //  5100 K
+    {242, 255, 237}, //  5200 K
+    {239, 255, 239}, //  5300 K
+    {237, 255, 242}, //  5400 K
+    {235, 255, 244}, //  5500 K
+    {233, 255, 247}, //  5600 K
+    {232, 255, 249}, //  5700 K
+    {230, 255, 251}, //  5800 K
+    {228, 255, 253}, //  5900 K
+    {226, 254, 255}, //  6000 K
+    {222, 252, 255}, //  6100 K
+    {219, 250, 255}, //  6200 K
+    {216, 248, 255}, //  6300 K
+    {213, 246, 255}, //  6400 K
+    {211, 244, 255}, //  6500 K
+};
+
+#endif // COLOR_TEMP_TABLE_H
@@ -27,13 +27,27 @@
 #define MQTT_USER "YOUR_MQTT_USERNAME"               // MQTT username
 #define MQTT_PASSWORD "YOUR_MQTT_PASSWORD"           // MQTT password
 #define MQTT_CLIENT_ID "Device_01"                   // Unique device identifier
+// Reconnects run off loop() (task on MQTT_CONNECT_TASK_CORE) and back off
+// exponentially with jitter between MQTT_BACKOFF_MIN_MS and MQTT_BACKOFF_MAX_MS
+#define MQTT_BACKOFF_MIN_MS 1000
+#define MQTT_BACKOFF_MAX_MS 60000
+#define MQTT_CONNECT_TIMEOUT_S 10    // TLS handshake and CONNECT round trip, each
+#define MQTT_CONNECT_TASK_CORE 0     // With the WiFi stack; loop() runs on core 1
 
 // ==================== LED Configuration ====================
 #define LED_PIN 18                  // WS2812 LED data pin
-#define NUM_LEDS 60                 // Number of LEDs in strip
+#define NUM_LEDS 60                 // Default strip length (a layout saved in Preferences overrides it)
+#define LED_MAX_LEDS 1200           // Largest strip a stored layout may describe
+#define LED_MAX_LAYERS 2            // Overlay layers on top of the mode (one strip buffer each)
 #define LED_TYPE WS2812             // LED type
 #define COLOR_ORDER GRB             // Color order
 #define DEFAULT_BRIGHTNESS 128      // Default brightness (0-255)
+#define LED_OUTPUT_CORE 0           // Core for the LED output task (loop() runs on core 1)
+#define LED_OUTPUT_INTERVAL_MS 10   // LED output task period (max refresh rate)
+#define LED_TRANSITION_MS 500       // Default crossfade between modes (0 = instant)
+#define LED_DITHER_BITS 2           // Temporal dithering below one LED step (0 = off, max 4).
+                                    // A 2^bits-frame cycle at LED_OUTPUT_INTERVAL_MS - lower the
+                                    // interval before going above 2 bits or low levels flicker
 
 // ==================== SSD1306 OLED Configuration ====================
 #define OLED_SDA 22                 // I2C SDA pin
@@ -50,19 +64,51 @@
 
 // ==================== Timing Configuration ====================
 #define SENSOR_READ_INTERVAL 1000       // Read sensors every 1 second
-#define DATA_SEND_INTERVAL 5000         // Send data to server every 5 seconds
+#define SENSOR_TASK_CORE 1              // Sensor task core; priority above loop(), so TLS/LED work cannot delay it
+#define SENSOR_TASK_PERIOD_MS 10        // Sensor task cycle (ADC drain, DS18B20 polling)
+#define SENSOR_QUEUE_LENGTH 8           // Snapshots buffered for loop() (power of two)
 #define NTP_UPDATE_INTERVAL 3600000     // Update time every hour
 #define DISPLAY_UPDATE_INTERVAL 500     // Update OLED display every 500ms
 
+// ==================== Telemetry Publishing ====================
+// Sensor data is published when a value moves by more than its deadband
+// (checked on every snapshot, at most once per TELEMETRY_MIN_INTERVAL_MS)
+// and otherwise once per TELEMETRY_HEARTBEAT_MS. All changeable over MQTT.
+#define TELEMETRY_MIN_INTERVAL_MS 1000      // Fastest rate while values are moving
+#define TELEMETRY_HEARTBEAT_MS 60000        // Longest silence when nothing changes
+#define TELEMETRY_DEADBAND_TEMPERATURE 0.1  // °C
+#define TELEMETRY_DEADBAND_TURBIDITY 2.0    // NTU
+#define TELEMETRY_DEADBAND_PH 0.05
+// Batch mode: records are collected and sent as one columnar message on
+// MQTT_TOPIC_SENSOR_BATCH once TELEMETRY_BATCH_SIZE are queued or the oldest
+// is TELEMETRY_BATCH_MAX_LATENCY_MS old. Size 0 sends every record on its own.
+#define TELEMETRY_BATCH_SIZE 0
+#define TELEMETRY_BATCH_MAX_LATENCY_MS 30000
+#define TELEMETRY_BATCH_CAPACITY 30         // Preallocated records (largest batch size)
+// Store-and-forward: records that could not be sent wait in a RAM ring,
+// spill to a LittleFS segment log and are replayed once MQTT is back
+#define TELEMETRY_RAM_RECORDS 64            // Tier 1: RAM ring
+#define TELEMETRY_SPILL_MS 300000           // Tier 1 -> 2 at the latest after this
+#define TELEMETRY_SEGMENT_RECORDS 256       // Records per log segment (~14 KB)
+#define TELEMETRY_LOG_MAX_SEGMENTS 16       // Oldest segment deleted beyond this
+#define TELEMETRY_REPLAY_BATCH 20           // Records per replay message
+#define TELEMETRY_REPLAY_INTERVAL_MS 2000   // Between replay messages
+
 // ==================== pH Sensor Configuration (Simulated) ====================
 #define PH_MIN 6.9                  // Minimum pH value for simulation
 #define PH_MAX 7.2                  // Maximum pH value for simulation
 
 // ==================== Turbidity Sensor Configuration ====================
 #define TURBIDITY_SENSOR_PIN 34     // Analog input pin for turbidity sensor
+#define TURBIDITY_SAMPLE_RATE_HZ 20000  // Continuous (DMA) ADC rate - the ESP32 minimum is 20 kHz
+#define TURBIDITY_BLOCK_MS 500          // Samples averaged per filter entry
+#define TURBIDITY_FILTER_WINDOW 20      // Blocks in the moving average (10 s), changeable over MQTT
+#define TURBIDITY_MIN_SPIKE_V 0.02      // Deviations below this are never treated as spikes
 
 // ==================== DS18B20 Temperature Sensor Configuration ====================
 #define DS18B20_PIN 21              // OneWire data pin
+#define DS18B20_RESOLUTION 12       // 9-12 bits; a 12-bit conversion takes ~750 ms (runs in the background)
+#define DS18B20_MAX_PROBES 4        // Probes on the bus (e.g. inflow, outflow, heater), converted together
 
 // ==================== NTP Configuration ====================
 #define NTP_SERVER "pool.ntp.org"   // NTP server address
@@ -1,6 +1,6 @@
 /**
  * @file ds18b20_sensor.h
- * @brief DS18B20 temperature sensor interface
+ * @brief DS18B20 temperature sensor interface (one or more probes on one bus)
  */
 
 #ifndef DS18B20_SENSOR_H
@@ -9,7 +9,21 @@
 #include <Arduino.h>
 #include <OneWire.h>
 #include <DallasTemperature.h>
+#include "config.h"
+#include "sensor_snapshot.h"
 
+// Conversion state machine - a 12-bit conversion takes ~750 ms, so it runs
+// in the background instead of blocking the main loop
+enum DS18B20State {
+    DS18B20_IDLE,        // No conversion running
+    DS18B20_CONVERTING   // Waiting for the probes to finish
+};
+
+// The bus is searched once in init(). Probe ROM addresses are kept in
+// Preferences, so a probe keeps its index (inflow, outflow, ...) across
+// reboots even when another one is unplugged; newly found probes are
+// appended. One convert command starts every probe at once and each is then
+// read by its address - one conversion time for N probes, no bus searches.
 class DS18B20Sensor {
 public:
     // Constructor
@@ -18,24 +32,55 @@ public:
     // Initialization
     bool init();
     
-    // Read sensor data
-    float readTemperature();           // Read temperature in Celsius
-    float readTemperatureFahrenheit(); // Read temperature in Fahrenheit
-    bool isConnected();                // Check if sensor is connected
-    int getDeviceCount();              // Get number of connected devices
-    
-    // Request new temperature reading (non-blocking)
+    // Start a conversion on all probes and return immediately
+    // (ignored while one is running)
     void requestTemperatures();
     
-    // Check if conversion is complete
+    // Check if the running conversion is complete
     bool isConversionComplete();
     
+    // Advance the state machine; call every loop. Returns true when a
+    // conversion finished with at least one valid reading during this call.
+    bool update();
+    
+    // Read sensor data - last completed conversion, never blocks
+    float readTemperature();           // First probe, in Celsius
+    float readTemperatureFahrenheit(); // First probe, in Fahrenheit
+    TemperatureReading getReading(uint8_t probe = 0);  // Last good conversion with its timestamp
+    bool isConnected();                // Some probe answered the last conversion
+    int getDeviceCount();              // Probes found by the search in init()
+    uint8_t getProbeCount();           // Probe slots, including saved ones now missing
+    bool getProbeAddress(uint8_t probe, DeviceAddress address);
+    
+    DS18B20State getState();
+    uint32_t getErrorCount();          // Failed or timed-out probe reads
+    
 private:
+    // Per-probe state; index = position in the saved address list
+    struct Probe {
+        DeviceAddress address;
+        float celsius;
+        unsigned long readingMs;
+        bool hasReading;
+        bool answered;                 // Found by init(), then: read back in the last conversion
+    };
+    
     uint8_t sensorPin;
     OneWire* oneWire;
     DallasTemperature* sensors;
-    float lastTemperature;
+    Probe probes[DS18B20_MAX_PROBES];
+    uint8_t probeCount;
+    uint8_t deviceCount;
     bool initialized;
+    
+    DS18B20State state;
+    unsigned long conversionStartMs;
+    uint16_t conversionTimeMs;         // Datasheet time for the resolution
+    uint32_t errorCount;
+    
+    uint8_t loadAddresses();           // Saved slots, returns their count
+    bool saveAddresses();
+    int findProbe(const DeviceAddress address);
 };
 
 #endif // DS18B20_SENSOR_H
@@ -0,0 +1,74 @@
+/**
+ * @file effect_random.h
+ * @brief Small seedable PRNG for LED effects (xorshift32)
+ */
+
+#ifndef EFFECT_RANDOM_H
+#define EFFECT_RANDOM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// One generator per effect instance, so effects don't share a sequence and a
+// given seed always reproduces the same frames. Bounded helpers scale with a
+// multiply-shift instead of a modulo (no division, negligible bias for the
+// small ranges effects use).
+class EffectRandom {
+public:
+    void seed(uint32_t value) {
+        // Scramble so nearby seeds give unrelated sequences; xorshift needs a non-zero state
+        value ^= value >> 16;
+        value *= 0x7FEB352DUL;
+        value ^= value >> 15;
+        value *= 0x846CA68BUL;
+        value ^= value >> 16;
+        state = value ? value : 0x9E3779B9UL;
+    }
+
+    uint32_t next32() {
+        uint32_t x = state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state = x;
+        return x;
+    }
+
+    // Fill a buffer with random bytes, four per generator step
+    void fill(uint8_t* bytes, size_t count) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            uint32_t x = next32();
+            bytes[i] = x;
+            bytes[i + 1] = x >> 8;
+            bytes[i + 2] = x >> 16;
+            bytes[i + 3] = x >> 24;
+        }
+        if (i < count) {
+            uint32_t x = next32();
+            for (; i < count; i++, x >>= 8) bytes[i] = x;
+        }
+    }
+
+    // Scale random bits onto [0, range) / [low, high)
+    static uint8_t scaleByte(uint8_t bits, uint8_t range) {
+        return ((uint16_t)bits * range) >> 8;
+    }
+    uint32_t below(uint32_t range) {
+        return ((uint64_t)next32() * range) >> 32;
+    }
+    int32_t range(int32_t low, int32_t high) {
+        if (high <= low) return low;
+        return low + (int32_t)below((uint32_t)(high - low));
+    }
+
+    // True with probability chance/256
+    bool chance8(uint8_t chance) {
+        return (next32() >> 24) < chance;
+    }
+
+private:
+    uint32_t state = 0x9E3779B9UL;
+};
+
+#endif // EFFECT_RANDOM_H
@@ -0,0 +1,44 @@
+/**
+ * @file highlight_renderer.h
+ * @brief Sparse point-light highlight renderer (sun, moon) for LED strips
+ */
+
+#ifndef HIGHLIGHT_RENDERER_H
+#define HIGHLIGHT_RENDERER_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+class HighlightRenderer {
+public:
+    static constexpr int MAX_SOURCES = 2;         // e.g. sun + moon
+    static constexpr int MAX_KERNEL_RADIUS = 15;  // Maximum highlight radius in LEDs
+    
+    // Constructor
+    HighlightRenderer();
+    
+    // Configure a light source (kernel is only rebuilt when the radius changes)
+    void setSource(uint8_t id, int center, uint8_t radius, uint8_t amplitude, CRGB color);
+    void disableSource(uint8_t id);
+    
+    // Blend every enabled source onto the strip, wrapping around the ends.
+    // Cost is O(2R+1) per source, independent of the strip length.
+    void render(CRGB* leds, int numLeds);
+    
+private:
+    struct LightSource {
+        bool enabled;
+        int center;          // LED index of the peak
+        uint8_t radius;      // Kernel radius in LEDs (<= MAX_KERNEL_RADIUS)
+        uint8_t amplitude;   // Peak blend weight (0-255)
+        CRGB color;
+        // Raised-cosine (Hann) kernel in Q0.8, only the first 2*radius+1 entries are used
+        uint8_t kernel[2 * MAX_KERNEL_RADIUS + 1];
+    };
+    
+    LightSource sources[MAX_SOURCES];
+    
+    void buildKernel(LightSource& source, uint8_t radius);
+};
+
+#endif // HIGHLIGHT_RENDERER_H
@@ -0,0 +1,60 @@
+/**
+ * @file led_compositor.h
+ * @brief Overlay layers blended on top of the segment frame
+ */
+
+#ifndef LED_COMPOSITOR_H
+#define LED_COMPOSITOR_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "config.h"
+#include "led_layout.h"
+
+enum LEDBlendMode {
+    BLEND_NORMAL,     // Crossfade towards the layer by its opacity
+    BLEND_ADD,        // Saturating add - black is transparent
+    BLEND_SCREEN,     // Brighten without clipping as hard as add
+    BLEND_MULTIPLY,   // Darken/tint the frame below
+    BLEND_LIGHTEN,    // Per-channel maximum
+    BLEND_MODE_COUNT  // Number of blend modes, keep last
+};
+
+// MQTT/JSON names ("normal", "add", ...)
+const char* getBlendModeName(LEDBlendMode mode);
+bool findBlendModeByName(const char* name, LEDBlendMode& mode);
+
+// Fixed set of full-strip layer buffers. Whoever renders into a layer
+// (LEDController runs an effect per layer) only fills pixels();
+// flatten() folds every enabled layer into the frame in a single pass over
+// it (all layers per cache-sized run) with 8-bit fixed-point blends.
+class LEDCompositor {
+public:
+    static const int MAX_LAYERS = LED_MAX_LAYERS;
+    static const int FRAME_BUFFERS = LED_MAX_LAYERS;   // Per-LED buffers taken from the pool
+    
+    LEDCompositor();
+    
+    bool begin(int numLeds, LEDBufferPool& pool);
+    
+    void setLayer(int index, LEDBlendMode blend, uint8_t opacity);
+    void disableLayer(int index);
+    bool isLayerEnabled(int index);
+    CRGB* pixels(int index);
+    
+    // Blend enabled layers, lowest index first, onto the frame in place
+    void flatten(CRGB* frame);
+    
+private:
+    struct Layer {
+        CRGB* pixels;
+        LEDBlendMode blend;
+        uint8_t opacity;
+        bool enabled;
+    };
+    
+    Layer layers[MAX_LAYERS];
+    int numLeds;
+};
+
+#endif // LED_COMPOSITOR_H
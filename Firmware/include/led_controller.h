@@ -10,14 +10,20 @@
 #include <FastLED.h>
 #include <ld2410.h>
 #include "config.h"
+#include "led_compositor.h"
+#include "led_effects.h"
+#include "led_layout.h"
+#include "led_pipeline.h"
+#include "led_sink.h"
 
-enum LEDMode {
-    MODE_OFF,
-    MODE_SKY_SIMULATION,
-    MODE_RAIN,
-    MODE_METEOR,
-    MODE_APOCALYPSE,
-    MODE_BASIC
+// Frame pacing statistics (cumulative since boot)
+struct LEDFrameStats {
+    uint32_t rendered;  // Frames rendered
+    uint32_t late;      // Frames rendered more than a quarter interval past their deadline
+    uint32_t dropped;   // Whole frame slots skipped because the loop was busy
+    uint32_t shown;     // Frames pushed to the output pipeline
+    uint32_t skipped;   // Frames not pushed because the framebuffer was unchanged
+    uint32_t flattenMaxUs;  // Longest overlay layer flatten pass
 };
 
 class LEDController {
@@ -26,7 +32,10 @@ public:
     LEDController();
     
     // Initialization
+    void setSink(LEDSink* outputSink);  // Optional, call before init() (default: FastLED strip)
+    void setLayout(const LEDLayout& layout);  // Optional, call before init() (default: one segment of NUM_LEDS)
     bool init();
+    const LEDLayout& getLayout();
     
     // Set radar sensor for automatic presence detection
     void setRadarSensor(ld2410* radarSensor);
@@ -35,25 +44,60 @@ public:
     void enableAutoDetection(bool enabled);  // Turn ON/OFF automatic detection
     bool isAutoDetectionEnabled();
     
-    // Mode control
-    void setMode(LEDMode mode);
+    // Mode control (transitionMs > 0 crossfades from the current effect)
+    void setMode(LEDMode mode, uint16_t transitionMs = 0);
     LEDMode getMode();
+    bool isTransitioning();
     void setBrightness(uint8_t brightness);
+    void setEffectSeed(uint32_t seed);  // Effects activated after this replay the same frames
     
-    // Main update loop
+    // Overlay layers (0..LED_MAX_LAYERS-1), each running its own effect over
+    // the whole strip on top of the mode. Hidden while the mode is off.
+    bool setLayer(uint8_t layer, LEDMode mode, LEDBlendMode blend, uint8_t opacity);
+    void clearLayer(uint8_t layer);
+    
+    // Main update loop (non-blocking, renders only when a frame is due)
     void update();
+    LEDFrameStats getFrameStats();
+    LEDPipelineStats getPipelineStats();
     
-    // Effect functions
-    void skySimulationEffect();
-    void rainEffect();
-    void meteorEffect();
-    void apocalypseEffect();
+    // Effect control
     void setCustomColor(uint8_t r, uint8_t g, uint8_t b);
     void off();
     
 private:
-    // LED array - using static array sized from config.h
-    CRGB leds[NUM_LEDS];
+    static const int FRAME_BUFFERS = 3;   // Two effect framebuffers + the composed frame
+    
+    // Strip layout and the per-LED buffers carved from one pool in init()
+    LEDLayout layout;
+    LEDBufferPool pool;
+    int numLeds = 0;
+    
+    // Each segment owns two effect instances. Both framebuffers span the whole
+    // strip and a segment renders into its own range, so the outgoing effect
+    // keeps animating in the other buffer during a crossfade.
+    struct SegmentState {
+        EffectSlot slots[2];
+        uint8_t active = 0;    // Slot (and framebuffer) of the current effect
+        bool fading = false;   // The other slot is the outgoing effect of a crossfade
+    };
+    SegmentState segmentStates[LED_MAX_SEGMENTS];
+    CRGB* effectBuffers[2] = {nullptr, nullptr};
+    CRGB* frameBuffer = nullptr;  // Segments composed in physical order, submitted to the pipeline
+    uint32_t effectSeed = 0;      // Advanced per activation so restarts differ
+    uint32_t nextEffectSeed();
+    LEDMode segmentMode(int segment);
+    void activateSegment(int segment, LEDMode mode, bool fade);
+    void composeFrame();
+    
+    // Overlay layers: buffers and blending in the compositor, effects here
+    LEDCompositor compositor;
+    EffectSlot layerSlots[LED_MAX_LAYERS];
+    
+    // Output: finished frames go through the double-buffered pipeline to the sink
+    FastLEDSink fastLedSink;
+    LEDSink* sink = &fastLedSink;
+    RenderPipeline pipeline;
     
     // Radar sensor for presence detection
     ld2410* radar = nullptr;
@@ -69,32 +113,25 @@ private:
     // Helper for presence detection
     bool checkPresence();
     
-    // Helper functions for sky simulation (formerly sunrise/sunset)
-    float getSunColorTemp(float hourFloat);
-    struct SkyColor {
-        uint8_t r, g, b;
-    };
-    SkyColor colorTempToRGB(float temp);
-    float planckRadiance(float lambda_nm, float T);
-    
-    // Effect state variables - initialized to prevent garbage values
-    unsigned long lastUpdate = 0;
-    int effectState = 0;
-    
-    // Convolution for smooth sky simulation transitions
-    // Arrays sized to match NUM_LEDS from config.h
-    float sunSignal[NUM_LEDS];
-    float convolvedSignal[NUM_LEDS];
-    void initConvolution();
-    void applySunConvolution(int centerIndex, float amplitude);
-    void buildSunKernel(int radius);
-    int getSunPositionIndex(float hourFloat);
-    float getSunIntensity(float hourFloat);
-    
-    // Raised-cosine kernel for point-like sun highlight
-    static constexpr int MAX_KERNEL_RADIUS = 15; // Maximum safe radius
-    int sunKernelRadius = 8; // adjustable highlight width in LEDs (must be <= MAX_KERNEL_RADIUS)
-    float sunKernel[NUM_LEDS];
+    // Crossfade state (alpha = elapsed / duration in 8-bit fixed point)
+    static constexpr uint16_t MAX_TRANSITION_MS = 10000;
+    bool transitionActive = false;
+    uint16_t transitionMs = 0;
+    uint32_t transitionElapsedMs = 0;
+    
+    // Frame pacing (fastest frame interval of the running effects)
+    uint16_t frameIntervalMs = 100;
+    unsigned long nextFrameMs = 0;   // Deadline of the next frame
+    unsigned long lastFrameMs = 0;   // When the previous frame was rendered
+    LEDFrameStats frameStats = {0, 0, 0, 0, 0, 0};
+    void restartFrameClock();
+    void updateFrameInterval();
+    
+    // Dirty tracking - frames are only submitted when the frame hash changes
+    uint32_t lastFrameHash = 0;
+    bool forceShow = true;   // Set when output changes outside the framebuffer (e.g. brightness)
+    uint32_t hashFrame();
+    void showIfChanged();
 };
 
 #endif // LED_CONTROLLER_H
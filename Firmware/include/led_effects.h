@@ -0,0 +1,86 @@
+/**
+ * @file led_effects.h
+ * @brief LED effect interface and table-driven effect registry
+ */
+
+#ifndef LED_EFFECTS_H
+#define LED_EFFECTS_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <time.h>
+#include "effect_random.h"
+
+enum LEDMode {
+    MODE_OFF,
+    MODE_SKY_SIMULATION,
+    MODE_RAIN,
+    MODE_METEOR,
+    MODE_APOCALYPSE,
+    MODE_BASIC,
+    LED_MODE_COUNT  // Number of modes, keep last
+};
+
+// Everything an effect needs to render one frame. Effects write perceptual
+// colours at full scale - gamma, brightness and dithering are applied once
+// at output (LEDOutputStage), never inside an effect.
+struct EffectContext {
+    CRGB* leds;          // Target buffer
+    int numLeds;
+    uint32_t dtMs;       // Time since the previous frame of this effect
+    CRGB customColor;    // User colour (MODE_BASIC)
+    time_t wallClock;    // Current time() - passed in so host tools can run a virtual day
+};
+
+// Base class for effects. Effect state lives in the object itself, so every
+// instance is independent and is reset by re-creating it.
+class LEDEffect {
+public:
+    virtual ~LEDEffect() {}
+    virtual void init() {}
+    virtual void render(EffectContext& ctx) = 0;
+    virtual void teardown() {}
+    
+    void seed(uint32_t value) { rng.seed(value); }
+
+protected:
+    EffectRandom rng;  // Per-instance randomness, seeded before init()
+};
+
+// Registry entry - one per LEDMode, indexed by mode
+struct EffectInfo {
+    LEDMode mode;
+    const char* name;          // MQTT/JSON name, e.g. "sky_simulation"
+    const char* label;         // Short OLED label, e.g. "SKY"
+    uint16_t frameIntervalMs;  // Target frame interval
+    LEDEffect* (*create)(void* storage);  // Construct the effect in preallocated storage
+};
+
+// Largest effect object an EffectSlot can hold (checked at compile time)
+#define EFFECT_STATE_SIZE 768
+
+// Look up registry entries (name lookup is for command parsing, not the hot path)
+const EffectInfo& getEffectInfo(LEDMode mode);
+const EffectInfo* findEffectByName(const char* name);
+
+// Preallocated home for one running effect instance
+class EffectSlot {
+public:
+    EffectSlot();
+    ~EffectSlot();
+
+    // Tear down the current effect and start a fresh instance of another one.
+    // The same seed reproduces the same frames.
+    void activate(const EffectInfo& info, uint32_t seed);
+    void release();
+
+    void render(EffectContext& ctx);
+    const EffectInfo* getInfo();
+
+private:
+    alignas(8) uint8_t storage[EFFECT_STATE_SIZE];
+    LEDEffect* effect;
+    const EffectInfo* info;
+};
+
+#endif // LED_EFFECTS_H
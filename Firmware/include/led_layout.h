@@ -0,0 +1,65 @@
+/**
+ * @file led_layout.h
+ * @brief Runtime strip layout (length, segments) and the LED buffer pool
+ *
+ * The layout is read from Preferences at boot, so one firmware build can
+ * drive any strip length up to LED_MAX_LEDS. Every per-LED buffer (effect
+ * framebuffers, pipeline buffers, sink output) is carved from one pool that
+ * is allocated once in LEDController::init() - nothing is allocated while
+ * frames are rendered.
+ */
+
+#ifndef LED_LAYOUT_H
+#define LED_LAYOUT_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "config.h"
+
+#define LED_MAX_SEGMENTS 4
+#define SEGMENT_FOLLOW_MODE 0xFF   // Segment shows the controller's current mode
+
+// A contiguous run of LEDs running its own effect instance
+struct LEDSegment {
+    uint16_t start;     // First physical LED
+    uint16_t length;
+    bool reversed;      // Effect index 0 maps to the last LED of the segment
+    uint8_t mode;       // LEDMode, or SEGMENT_FOLLOW_MODE; dark while the controller is off
+};
+
+struct LEDLayout {
+    uint16_t numLeds;
+    uint8_t segmentCount;
+    LEDSegment segments[LED_MAX_SEGMENTS];
+};
+
+// One forward segment over NUM_LEDS that follows the controller mode
+void defaultLEDLayout(LEDLayout& layout);
+
+// Segments must lie inside the strip and must not overlap
+bool validateLEDLayout(const LEDLayout& layout);
+
+// Persisted layout, or the default one if none is stored / it is invalid
+bool loadLEDLayout(LEDLayout& layout);
+bool saveLEDLayout(const LEDLayout& layout);
+
+// Fixed-size CRGB arena: allocate() once at startup, then components take()
+// their slices. Nothing is ever freed back individually.
+class LEDBufferPool {
+public:
+    LEDBufferPool();
+    ~LEDBufferPool();
+    
+    bool allocate(size_t ledCount);
+    CRGB* take(size_t ledCount);   // nullptr when the pool is exhausted
+    
+    size_t getCapacity();
+    size_t getUsed();
+    
+private:
+    CRGB* memory;
+    size_t capacity;
+    size_t used;
+};
+
+#endif // LED_LAYOUT_H
@@ -0,0 +1,40 @@
+/**
+ * @file led_output_stage.h
+ * @brief Final per-pixel stage: gamma, global brightness and temporal dithering
+ */
+
+#ifndef LED_OUTPUT_STAGE_H
+#define LED_OUTPUT_STAGE_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+// Effects render perceptual colours at full scale; this stage turns them into
+// what the strip should emit. Gamma and brightness are folded into one
+// 256-entry table (rebuilt only when brightness changes) that keeps
+// ditherBits of fraction below one LED step. Each frame adds a per-pixel
+// threshold that cycles over 2^ditherBits frames, so a value between two
+// steps is shown as the right mix of both instead of rounding down to a band.
+class LEDOutputStage {
+public:
+    static const uint8_t MAX_DITHER_BITS = 4;
+    
+    LEDOutputStage();
+    
+    void configure(uint8_t brightness, uint8_t ditherBits);
+    
+    // One integer pass from the rendered frame into the output buffer. Returns
+    // true while the frame still has sub-step detail, i.e. it has to be shown
+    // again with the next dither phase even if nothing new was rendered.
+    bool apply(const CRGB* frame, CRGB* output, int numLeds);
+    
+private:
+    uint16_t lut[256];   // Perceptual value -> linear drive with ditherBits of fraction
+    uint8_t brightness;
+    uint8_t ditherBits;
+    uint8_t phase;       // Dither frame counter
+    
+    void rebuild();
+};
+
+#endif // LED_OUTPUT_STAGE_H
@@ -0,0 +1,92 @@
+/**
+ * @file led_pipeline.h
+ * @brief Double-buffered LED render pipeline with a dedicated output task
+ *
+ * The main loop renders into its own framebuffer and submit()s finished
+ * frames into the back buffer. The output task (pinned to the other core
+ * on ESP32, a std::thread on the host) swaps buffers at a steady rate and
+ * transmits the front buffer through an LEDSink, so network/sensor stalls
+ * in loop() no longer show up as animation jitter. Gamma, brightness and
+ * dithering (LEDOutputStage) also run on the output side.
+ */
+
+#ifndef LED_PIPELINE_H
+#define LED_PIPELINE_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "config.h"
+#include "led_output_stage.h"
+#include "led_sink.h"
+
+#ifdef ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif
+
+struct LEDPipelineStats {
+    uint32_t submitted;    // Frames handed over by the renderer
+    uint32_t shown;        // Frames transmitted by the output task
+    uint32_t overwritten;  // Frames replaced by a newer one before being shown
+    uint32_t refreshed;    // Extra shows of an unchanged frame to advance the dither pattern
+};
+
+class RenderPipeline {
+public:
+    static const int FRAME_BUFFERS = 3;   // Per-LED buffers taken from the pool
+    
+    RenderPipeline();
+    ~RenderPipeline();
+    
+    bool begin(LEDSink* sink, int numLeds, LEDBufferPool& pool);
+    
+    // Start the output task (calls service() every periodMs)
+    bool startTask(int core, uint32_t periodMs);
+    void stopTask();
+    
+    // Renderer side: copy a finished frame into the back buffer (never blocks on output)
+    void submit(const CRGB* frame, uint8_t brightness);
+    
+    // Output side: swap in a pending frame (or re-dither the current one) and
+    // transmit it. Called by the task; can also be called directly when no
+    // task is running.
+    void service();
+    
+    LEDPipelineStats getStats();
+    
+private:
+    LEDSink* sink;
+    int numLeds;
+    
+    CRGB* front;
+    CRGB* back;
+    uint8_t backBrightness;
+    volatile bool frameReady;   // Back buffer holds a frame not yet shown
+    
+    // Output side only
+    LEDOutputStage outputStage;
+    CRGB* output;               // Front buffer after the output stage
+    bool ditherPending;         // Front frame needs more dither phases
+    
+    LEDPipelineStats stats;
+    uint32_t periodMs;
+    
+#ifdef ESP32
+    portMUX_TYPE swapLock;
+    TaskHandle_t taskHandle;
+    static void taskEntry(void* arg);
+#else
+    std::mutex swapLock;
+    std::thread outputThread;
+    std::atomic<bool> running;
+#endif
+    
+    void lock();
+    void unlock();
+};
+
+#endif // LED_PIPELINE_H
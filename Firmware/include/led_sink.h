@@ -0,0 +1,62 @@
+/**
+ * @file led_sink.h
+ * @brief LED output sinks - where finished frames are transmitted
+ */
+
+#ifndef LED_SINK_H
+#define LED_SINK_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "config.h"
+#include "led_layout.h"
+
+// Abstract destination for finished frames
+class LEDSink {
+public:
+    static const int MAX_FRAME_BUFFERS = 1;   // Most per-LED buffers a sink takes from the pool
+    
+    virtual ~LEDSink() {}
+    virtual bool begin(int numLeds, LEDBufferPool& pool) = 0;
+    // Transmit one frame (already gamma corrected, scaled and dithered);
+    // called from the LED output task only
+    virtual void show(const CRGB* frame, int numLeds) = 0;
+};
+
+// WS2812 strip driven through FastLED
+class FastLEDSink : public LEDSink {
+public:
+    bool begin(int numLeds, LEDBufferPool& pool) override;
+    void show(const CRGB* frame, int numLeds) override;
+    
+private:
+    CRGB* output = nullptr;  // Buffer registered with FastLED (from the pool)
+    int numLeds = 0;
+};
+
+// Records frame timing instead of driving hardware (host runs, diagnostics)
+class RecordingSink : public LEDSink {
+public:
+    static const int HISTORY_SIZE = 64;
+    
+    bool begin(int numLeds, LEDBufferPool& pool) override;
+    void show(const CRGB* frame, int numLeds) override;
+    
+    uint32_t getFrameCount();
+    uint32_t getLastFrameHash();  // FNV-1a of the last frame, for comparisons
+    // Interval between the last shows in microseconds (index 0 = most recent)
+    uint32_t getInterval(int age);
+    uint32_t getMinInterval();
+    uint32_t getMaxInterval();
+    
+private:
+    uint32_t frameCount = 0;
+    uint32_t lastFrameHash = 0;
+    unsigned long lastShowUs = 0;
+    uint32_t intervals[HISTORY_SIZE];
+    int historyIndex = 0;
+    uint32_t minInterval = 0xFFFFFFFF;
+    uint32_t maxInterval = 0;
+};
+
+#endif // LED_SINK_H
@@ -11,18 +11,47 @@
 #include <PubSubClient.h>
 #include <WiFiClientSecure.h>
 #include <ArduinoJson.h>
+#include <atomic>
 #include "config.h"
 
+#ifdef ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 // MQTT Topics
 #define MQTT_TOPIC_LED_CONTROL "iot/device01/led/control"
 #define MQTT_TOPIC_LED_STATUS "iot/device01/led/status"
 #define MQTT_TOPIC_RADAR_CONTROL "iot/device01/radar/control"
 #define MQTT_TOPIC_RADAR_STATUS "iot/device01/radar/status"
 #define MQTT_TOPIC_SENSOR_DATA "iot/device01/sensors"
+#define MQTT_TOPIC_SENSOR_CONTROL "iot/device01/sensors/control"
+#define MQTT_TOPIC_SENSOR_BATCH "iot/device01/sensors/batch"
 #define MQTT_TOPIC_TEMPERATURE "iot/device01/temperature"
 #define MQTT_TOPIC_TURBIDITY "iot/device01/turbidity"
 #define MQTT_TOPIC_STATUS "iot/device01/status"
 
+enum MQTTConnectionState {
+    MQTT_STATE_WAITING,      // Disconnected; next attempt after the backoff
+    MQTT_STATE_CONNECTING,   // TCP + TLS handshake + CONNECT in progress
+    MQTT_STATE_CONNECTED
+};
+
+struct MQTTConnectionStats {
+    uint32_t attempts;
+    uint32_t failures;
+    uint32_t lastAttemptMs;      // Duration of the last attempt, ok or not
+    uint32_t maxAttemptMs;
+    uint32_t connectingMs;       // Total time spent in attempts
+    uint32_t retryInMs;          // Until the next attempt (while waiting)
+};
+
+// Connecting never blocks loop(): on ESP32 the attempt runs in a separate
+// task and loop() only picks up its result; the host build runs it inline.
+// Failed attempts back off exponentially with jitter, so a device fleet
+// doesn't reconnect in lockstep after a broker outage. Callers only see
+// isConnected() - while it is false, publish*() return false at once and
+// telemetry goes to the store-and-forward queue.
 class MQTTHandler {
 public:
     // Constructor
@@ -32,10 +61,13 @@ public:
     bool init();
     
     // Connection management
-    bool connect();
+    bool connect();              // Attempt now instead of after the backoff
     void disconnect();
     bool isConnected();
     void loop();
+    MQTTConnectionState getState();
+    static const char* getStateName(MQTTConnectionState state);
+    MQTTConnectionStats getStats();
     
     // Publishing
     bool publishSensorData(float temperature, float turbidity, String waterQuality);
@@ -52,11 +84,27 @@ public:
 private:
     WiFiClientSecure wifiClient;
     PubSubClient* mqttClient;
-    unsigned long lastReconnectAttempt;
-    static const unsigned long RECONNECT_INTERVAL = 5000;
+    
+    MQTTConnectionState state;
+    unsigned long nextAttemptMs;
+    unsigned long attemptStartMs;
+    uint8_t consecutiveFailures;
+    MQTTConnectionStats stats;
+    
+    // Written by the connect task, read by loop()
+    std::atomic<bool> attemptDone;
+    std::atomic<bool> attemptConnected;
+#ifdef ESP32
+    TaskHandle_t connectTask;
+    static void connectTaskEntry(void* arg);
+#endif
     
     // SSL/TLS configuration
     void setupTLS();
+    
+    void startAttempt(unsigned long now);
+    void finishAttempt(bool connected, unsigned long now);
+    void scheduleRetry(unsigned long now);
 };
 
 #endif // MQTT_HANDLER_H
@@ -0,0 +1,97 @@
+/**
+ * @file particle_system.h
+ * @brief Fixed-capacity 1D particle engine for LED effects (meteors, rain, lightning)
+ */
+
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "effect_random.h"
+
+enum ParticleShape {
+    PARTICLE_POINT,   // Single LED
+    PARTICLE_TRAIL,   // Head plus a tail behind the direction of motion
+    PARTICLE_GLOW     // Symmetric triangle around the position
+};
+
+enum ParticleSpawn {
+    SPAWN_ANYWHERE,   // Uniform over the strip
+    SPAWN_MIDDLE      // Middle third of the strip
+};
+
+// What a particle looks like and how often new ones appear. Rates are per
+// 100 LEDs so a preset looks the same density on any strip length.
+struct ParticlePreset {
+    uint16_t spawnRate;    // Particles per second per 100 LEDs, 8.8 fixed point
+    uint16_t lifeMinMs;    // Brightness fades linearly to zero over the life
+    uint16_t lifeMaxMs;
+    int16_t speedMin;      // LEDs per second (negative = towards LED 0)
+    int16_t speedMax;
+    CRGB color;
+    uint8_t colorJitter;   // Random dimming of each particle's colour (0-255)
+    ParticleShape shape;
+    uint8_t size;          // Trail length / glow radius in LEDs
+    ParticleSpawn spawn;
+};
+
+// Standard presets used by the effects
+extern const ParticlePreset PARTICLE_PRESET_METEOR;
+extern const ParticlePreset PARTICLE_PRESET_RAIN;
+extern const ParticlePreset PARTICLE_PRESET_LIGHTNING;
+
+struct Particle {
+    int32_t pos;       // LED index, 16.16 fixed point
+    int16_t vel;       // LEDs per second, 8.8 fixed point
+    uint16_t energy;   // Brightness, 8.8 fixed point - 0 = dead
+    uint16_t decay;    // Energy lost per ms
+    CRGB color;
+};
+
+// Particles live in a caller-provided array (normally a member of the
+// effect, so they sit in the EffectSlot storage) and are kept packed at the
+// front of it: spawning appends, dying swaps in the last one. Per-frame cost
+// is bounded by capacity x shape size, whatever the strip length; spawns
+// beyond capacity are dropped. Motion and ageing follow the frame time, and
+// rendering is additive (saturating), so particles overlap in any order.
+class ParticleSystem {
+public:
+    static constexpr uint8_t MAX_SIZE = 16;          // Longest trail / widest glow
+    static constexpr uint32_t MAX_STEP_MS = 1000;    // Longer frame gaps are clamped
+
+    ParticleSystem();
+
+    void begin(Particle* pool, uint8_t capacity, const ParticlePreset& preset);
+    void clear();
+
+    // Spawn-rate control (8.8 particles per second per 100 LEDs, 0 = manual spawns only)
+    void setSpawnRate(uint16_t rate);
+    uint16_t getSpawnRate();
+
+    // Spawn one particle now; false when the pool is full
+    bool spawn(int numLeds, EffectRandom& rng);
+
+    // Spawn from the rate, then move and age every particle by dtMs
+    void update(uint32_t dtMs, int numLeds, EffectRandom& rng);
+
+    // Add every live particle onto the strip
+    void render(CRGB* leds, int numLeds);
+
+    uint8_t getActiveCount();
+
+private:
+    Particle* pool;
+    uint8_t capacity;
+    uint8_t count;
+    const ParticlePreset* preset;
+    uint16_t spawnRate;
+    uint32_t spawnCredit;     // Accumulated spawns, SPAWN_UNIT each
+    uint32_t nextSpawnCost;   // Jittered cost of the next spawn (0.5-1.5 units)
+
+    void kill(uint8_t index);
+    void drawTrail(const Particle& p, CRGB color, CRGB* leds, int numLeds);
+    void drawGlow(const Particle& p, CRGB color, CRGB* leds, int numLeds);
+};
+
+#endif // PARTICLE_SYSTEM_H
@@ -0,0 +1,84 @@
+/**
+ * @file publish_policy.h
+ * @brief Send-on-delta / heartbeat decision for sensor telemetry
+ */
+
+#ifndef PUBLISH_POLICY_H
+#define PUBLISH_POLICY_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "sensor_snapshot.h"
+
+// Fields with their own deadband
+enum TelemetryField {
+    TELEMETRY_TEMPERATURE,   // Every probe
+    TELEMETRY_TURBIDITY,
+    TELEMETRY_PH,
+    TELEMETRY_FIELD_COUNT
+};
+
+// Why a snapshot was (or would have been) published
+enum PublishReason {
+    PUBLISH_NONE,            // Suppressed
+    PUBLISH_FIRST,           // Nothing sent yet
+    PUBLISH_STATE,           // A reading became valid/invalid, or the water quality class changed
+    PUBLISH_DELTA,           // A value moved by at least its deadband
+    PUBLISH_HEARTBEAT        // Nothing changed for heartbeatMs
+};
+
+struct PublishPolicyConfig {
+    float deadband[TELEMETRY_FIELD_COUNT];   // <= 0: any change publishes
+    uint32_t minIntervalMs;                  // Fastest publish rate
+    uint32_t heartbeatMs;                    // Longest silence
+};
+
+struct PublishPolicyStats {
+    uint32_t sent;           // Delivered to the client (byState + byDelta + byHeartbeat + first)
+    uint32_t suppressed;     // Snapshots not published
+    uint32_t byState;
+    uint32_t byDelta;
+    uint32_t byHeartbeat;
+    uint32_t failed;         // Due but not delivered to the client (stored for replay); not in sent
+};
+
+// Compares every snapshot against the last one actually sent. Values that
+// stay inside their deadband are suppressed until the heartbeat; a value
+// that moves is sent on the next snapshot (at most once per minIntervalMs),
+// so the rate follows how fast the water changes - one message per minute
+// when it is steady, one per second during a turbidity spike.
+class PublishPolicy {
+public:
+    PublishPolicy();
+    
+    void setConfig(const PublishPolicyConfig& config);
+    PublishPolicyConfig getConfig();
+    static PublishPolicyConfig defaultConfig();
+    
+    // Decide for one snapshot; counts it as suppressed when the answer is
+    // PUBLISH_NONE. Nothing else changes until markSent().
+    PublishReason evaluate(const SensorSnapshot& snapshot);
+    
+    // The snapshot went out - it becomes the reference for the deadbands
+    void markSent(const SensorSnapshot& snapshot, PublishReason reason);
+    // Publishing failed (offline) and the record was stored for replay. It
+    // still becomes the deadband reference, so the outage does not turn
+    // every following snapshot into a delta, but counts as failed, not sent.
+    void markStored(const SensorSnapshot& snapshot);
+    
+    PublishPolicyStats getStats();
+    static const char* getReasonName(PublishReason reason);
+    
+private:
+    PublishPolicyConfig config;
+    PublishPolicyStats stats;
+    
+    // Last snapshot sent or stored for replay (the deadband reference)
+    bool hasSent;
+    SensorSnapshot reference;
+    
+    bool stateChanged(const SensorSnapshot& snapshot);
+    bool moved(float value, float last, TelemetryField field);
+};
+
+#endif // PUBLISH_POLICY_H
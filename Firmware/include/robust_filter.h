@@ -0,0 +1,60 @@
+/**
+ * @file robust_filter.h
+ * @brief Incremental moving average with spike rejection, O(1) per sample
+ */
+
+#ifndef ROBUST_FILTER_H
+#define ROBUST_FILTER_H
+
+#include <stdint.h>
+
+// Moving mean over the last `window` accepted samples. A sample further than
+// `sigmas` standard deviations (at least `minDeviation`) from the current
+// mean is rejected as a spike; a run of rejections longer than half the
+// window is a real level change, so the window restarts from it.
+//
+// Running sum and sum of squares are updated as samples enter and leave the
+// ring, so add() costs the same for any window size. Values are held as
+// integers in units of 1/SCALE, which keeps the sums exact (no drift).
+class RobustFilter {
+public:
+    static const uint16_t MAX_WINDOW = 128;
+    static const int32_t SCALE = 10000;
+
+    RobustFilter();
+
+    // Runtime window length (1..MAX_WINDOW); restarts the filter
+    void setWindow(uint16_t size);
+    uint16_t getWindow();
+    void setRejection(float sigmas, float minDeviation);
+    void reset();
+
+    // Add one sample; false when it was rejected as a spike
+    bool add(float value);
+
+    float getMean();
+    float getStdDev();
+    uint16_t getCount();          // Samples in the window
+    uint32_t getRejectedCount();  // Since the last reset
+
+private:
+    static const uint16_t MIN_SAMPLES_TO_REJECT = 3;
+
+    int32_t ring[MAX_WINDOW];
+    uint16_t window;
+    uint16_t head;                // Oldest sample once the window is full
+    uint16_t count;
+    int64_t sum;
+    int64_t sumSquares;
+
+    float sigmasSquared;
+    int64_t minDeviation;         // In 1/SCALE units
+    uint16_t consecutiveRejects;
+    uint32_t rejectedCount;
+
+    void restart();               // Empty the window, keep the counters
+    bool isSpike(int32_t value);
+    void push(int32_t value);
+};
+
+#endif // ROBUST_FILTER_H
@@ -0,0 +1,55 @@
+/**
+ * @file sensor_snapshot.h
+ * @brief Per-cycle sensor readings shared by MQTT, the OLED and local rules
+ */
+
+#ifndef SENSOR_SNAPSHOT_H
+#define SENSOR_SNAPSHOT_H
+
+#include <Arduino.h>
+#include "config.h"
+
+enum WaterQuality {
+    WATER_QUALITY_UNKNOWN,       // No reading yet
+    WATER_QUALITY_SENSOR_ERROR,
+    WATER_QUALITY_EXCELLENT,     // < 5 NTU
+    WATER_QUALITY_GOOD,          // < 50 NTU
+    WATER_QUALITY_FAIR,          // < 100 NTU
+    WATER_QUALITY_POOR,          // < 500 NTU
+    WATER_QUALITY_VERY_POOR
+};
+
+WaterQuality classifyWaterQuality(float ntu);
+// Published name ("Excellent", "Sensor Error", ...)
+const char* getWaterQualityName(WaterQuality quality);
+
+// One finished DS18B20 conversion
+struct TemperatureReading {
+    float celsius;               // DEVICE_DISCONNECTED_C when not valid
+    unsigned long timestampMs;   // millis() when the conversion was read
+    bool valid;
+};
+
+// One finished turbidity block, classified once when it was produced
+struct TurbidityReading {
+    float ntu;                   // Negative on sensor error
+    float voltage;               // Mean of the last block, before filtering
+    float filteredVoltage;       // Moving average the NTU was computed from
+    WaterQuality quality;
+    unsigned long timestampMs;   // millis() when the block finished
+    bool valid;
+};
+
+// Everything measured in one sensor cycle. Taken once per
+// SENSOR_READ_INTERVAL and only read afterwards - every consumer sees the
+// same values without touching the hardware again.
+struct SensorSnapshot {
+    uint32_t sequence;           // Increments every cycle, 0 = none taken yet
+    unsigned long timestampMs;   // millis() when the snapshot was taken
+    TemperatureReading temperatures[DS18B20_MAX_PROBES];  // By probe slot
+    uint8_t temperatureCount;    // Probe slots in use
+    TurbidityReading turbidity;
+    float ph;                    // Simulated
+};
+
+#endif // SENSOR_SNAPSHOT_H
@@ -0,0 +1,92 @@
+/**
+ * @file sensor_task.h
+ * @brief Sensor acquisition task feeding snapshots to loop() through a lock-free ring
+ *
+ * The task (a FreeRTOS task on ESP32, a std::thread on the host) runs every
+ * SENSOR_TASK_PERIOD_MS: it drains the turbidity ADC, polls the DS18B20
+ * conversion and, every SENSOR_READ_INTERVAL, takes a timestamped
+ * SensorSnapshot and pushes it into an SPSCRing. loop() drains the ring and
+ * does the JSON/MQTT/OLED work, so TLS or LED rendering no longer delay
+ * sampling.
+ */
+
+#ifndef SENSOR_TASK_H
+#define SENSOR_TASK_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "ds18b20_sensor.h"
+#include "sensor_snapshot.h"
+#include "spsc_ring.h"
+#include "turbidity_sensor.h"
+
+#ifdef ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <atomic>
+#include <thread>
+#endif
+
+struct SensorTaskStats {
+    uint32_t cycles;       // Task cycles run
+    uint32_t samples;      // Snapshots queued
+    uint32_t dropped;      // Snapshots lost to a full queue
+    uint32_t lateMaxUs;    // Worst wake-up delay past the schedule (since the last getStats())
+    uint32_t busyMaxUs;    // Longest cycle (since the last getStats())
+};
+
+class SensorTask {
+public:
+    SensorTask();
+    ~SensorTask();
+    
+    // phSource supplies the (simulated) pH for each snapshot
+    void begin(DS18B20Sensor* temperature, TurbiditySensor* turbidity, float (*phSource)());
+    
+    // Start the task (calls service() every periodMs)
+    bool startTask(int core, uint32_t periodMs);
+    void stopTask();
+    bool isRunning();
+    
+    // One acquisition cycle. Called by the task; can also be called directly
+    // when no task is running.
+    void service();
+    
+    // Consumer side (loop()): oldest queued snapshot, false when none
+    bool poll(SensorSnapshot& snapshot);
+    
+    // Applied by the task at its next cycle - the sensors belong to it
+    void setTurbidityWindow(uint16_t blocks);
+    
+    SensorTaskStats getStats();
+    
+private:
+    DS18B20Sensor* temperatureSensor;
+    TurbiditySensor* turbiditySensor;
+    float (*readPH)();
+    
+    // Task side only
+    unsigned long nextSnapshotMs;
+    
+    SPSCRing<SensorSnapshot, SENSOR_QUEUE_LENGTH> queue;
+    std::atomic<uint32_t> sequence;        // Written by the task, read by getStats()
+    std::atomic<uint16_t> pendingWindow;   // 0 = no change requested
+    std::atomic<uint32_t> cycles;
+    std::atomic<uint32_t> lateMaxUs;
+    std::atomic<uint32_t> busyMaxUs;
+    uint32_t periodMs;
+    
+    void takeSnapshot();
+    void runCycle(unsigned long scheduledUs);
+    
+#ifdef ESP32
+    TaskHandle_t taskHandle;
+    static void taskEntry(void* arg);
+#else
+    std::thread sensorThread;
+    std::atomic<bool> running;
+#endif
+};
+
+#endif // SENSOR_TASK_H
@@ -0,0 +1,65 @@
+/**
+ * @file spsc_ring.h
+ * @brief Lock-free single-producer / single-consumer ring buffer
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <atomic>
+
+// Fixed-capacity queue between exactly one producer and one consumer
+// (e.g. a sensor task and loop()). Each side owns one index: the
+// producer only writes head, the consumer only writes tail, and the
+// release/acquire pair on them publishes the slot contents - no lock, no
+// critical section, neither side ever waits for the other.
+//
+// When full, push() drops the new item (the producer cannot touch tail) and
+// counts it. CAPACITY must be a power of two; indices run freely and wrap.
+template <typename T, uint32_t CAPACITY>
+class SPSCRing {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "SPSCRing capacity must be a power of two");
+
+public:
+    SPSCRing() : head(0), tail(0), dropped(0) {}
+
+    // Producer side; false (and counted) when the ring is full
+    bool push(const T& item) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        slots[h & (CAPACITY - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; false when the ring is empty
+    bool pop(T& item) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = slots[t & (CAPACITY - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side; only a snapshot while the other side is running
+    uint32_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+    static uint32_t capacity() { return CAPACITY; }
+    uint32_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    T slots[CAPACITY];
+    std::atomic<uint32_t> head;      // Next slot to write (producer)
+    std::atomic<uint32_t> tail;      // Next slot to read (consumer)
+    std::atomic<uint32_t> dropped;
+};
+
+#endif // SPSC_RING_H
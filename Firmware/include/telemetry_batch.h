@@ -0,0 +1,84 @@
+/**
+ * @file telemetry_batch.h
+ * @brief Columnar multi-record sensor messages with delta-encoded timestamps
+ */
+
+#ifndef TELEMETRY_BATCH_H
+#define TELEMETRY_BATCH_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "sensor_snapshot.h"
+#include "window_aggregator.h"
+
+// One published data point: the window summary the single-message path
+// would have sent. Fixed size; NAN where a sensor had no valid reading.
+struct TelemetryRecord {
+    uint32_t timestampMs;            // Last snapshot in the window
+    uint16_t samples;                // Snapshots in the window
+    uint8_t temperatureCount;
+    uint8_t quality;                 // WaterQuality of the last turbidity reading
+    float temperature[DS18B20_MAX_PROBES];   // Means per probe
+    float temperatureMin;            // First probe
+    float temperatureMax;
+    float turbidity;
+    float turbidityMin;
+    float turbidityMax;
+    float ph;
+    float phMin;
+    float phMax;
+};
+
+TelemetryRecord makeTelemetryRecord(const SensorSnapshot& snapshot, const TelemetrySummary& summary);
+
+struct TelemetryBatchStats {
+    uint32_t messages;     // Batches sent
+    uint32_t records;      // Records sent in them
+    uint32_t dropped;      // Oldest records overwritten while the batch was full
+};
+
+// Records wait in a preallocated array and go out as one message:
+//   {"t0": 120000, "n": 3, "dt": [0, 1000, 4000], "samples": [...],
+//    "temperature": [...], "turbidity": [...], ...}
+// t0 is the first record's timestamp and dt the milliseconds since the
+// previous record, so field names and full timestamps appear once per batch.
+class TelemetryBatch {
+public:
+    TelemetryBatch();
+    
+    // 0 or 1 = batching off (every record is due immediately)
+    void setConfig(uint16_t size, uint32_t maxLatencyMs);
+    uint16_t getSize();
+    uint32_t getMaxLatency();
+    bool isEnabled();
+    
+    // Full: the oldest record is dropped (counted)
+    void add(const TelemetryRecord& record);
+    bool isDue(unsigned long now);   // Size reached or oldest record too old
+    uint16_t getCount();
+    const TelemetryRecord* getRecords();   // Oldest first
+    
+    // Build the message for every queued record; markSent() once it went out
+    void toJson(JsonDocument& doc);
+    size_t jsonCapacity();           // DynamicJsonDocument size for toJson()
+    void markSent();                 // Counts the batch and empties it
+    void clear();                    // Empties it (records were handed elsewhere)
+    
+    TelemetryBatchStats getStats();
+    
+    // The same message for any run of records (store-and-forward replay)
+    static void toJson(JsonDocument& doc, const TelemetryRecord* records, uint16_t count);
+    static size_t jsonCapacity(const TelemetryRecord* records, uint16_t count);
+    
+private:
+    TelemetryRecord records[TELEMETRY_BATCH_CAPACITY];
+    uint16_t count;
+    uint16_t size;
+    uint32_t maxLatencyMs;
+    TelemetryBatchStats stats;
+    
+    static uint8_t probeColumns(const TelemetryRecord* records, uint16_t count);
+};
+
+#endif // TELEMETRY_BATCH_H
@@ -0,0 +1,89 @@
+/**
+ * @file telemetry_store.h
+ * @brief Store-and-forward buffer for sensor records sent while MQTT is down
+ */
+
+#ifndef TELEMETRY_STORE_H
+#define TELEMETRY_STORE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "telemetry_batch.h"
+
+struct TelemetryStoreStats {
+    uint32_t stored;       // Records handed to the store
+    uint32_t spilled;      // Written from RAM to the log
+    uint32_t replayed;     // Sent again and removed
+    uint32_t dropped;      // Lost: RAM full without a log, or oldest segment deleted
+    uint32_t writeErrors;  // Short or failed log writes
+};
+
+// Two tiers, oldest records always in the lower one:
+//  1. a RAM ring of TELEMETRY_RAM_RECORDS, so a short outage costs no flash
+//     writes;
+//  2. an append-only log on LittleFS, /tlm/NNNNNNNN.seg, each segment a
+//     header plus up to TELEMETRY_SEGMENT_RECORDS raw TelemetryRecords. The
+//     ring spills into it when full or TELEMETRY_SPILL_MS after its first
+//     record; beyond TELEMETRY_LOG_MAX_SEGMENTS the oldest segment is deleted.
+// Replay reads the log first, then the ring, in order. The read position in
+// the oldest segment is kept in Preferences, so a reboot resends nothing
+// that was already confirmed. Timestamps are millis() of the boot that took
+// them - every segment records that boot number.
+class TelemetryStore {
+public:
+    TelemetryStore();
+    
+    // Mounts LittleFS and picks up segments left by earlier boots; false =
+    // no log, records are kept in RAM only
+    bool begin();
+    uint32_t getBoot();              // Increments on every begin()
+    
+    void add(const TelemetryRecord& record);
+    void service(unsigned long now); // Spills the ring once TELEMETRY_SPILL_MS old
+    void flush();                    // Ring to the log now
+    
+    bool hasBacklog();
+    uint32_t getBacklogCount();
+    uint16_t getRamCount();
+    uint32_t getLogCount();
+    uint32_t getSegmentCount();
+    
+    // Copies up to `max` of the oldest records (all from one boot, returned
+    // in `boot`) without removing them; consume() them once they were sent
+    uint16_t peek(TelemetryRecord* out, uint16_t max, uint32_t& boot);
+    void consume(uint16_t count);
+    
+    TelemetryStoreStats getStats();
+    
+private:
+    enum Source { SOURCE_NONE, SOURCE_LOG, SOURCE_RAM };
+    
+    TelemetryRecord ram[TELEMETRY_RAM_RECORDS];
+    uint16_t ramHead;                // Oldest record
+    uint16_t ramCount;
+    unsigned long ramSinceMs;        // millis() when the ring stopped being empty
+    
+    bool logReady;
+    bool spillBlocked;               // A log write failed at spillBlockedMs
+    unsigned long spillBlockedMs;
+    uint32_t boot;
+    uint32_t oldestSegment;          // Segments are numbered oldestSegment..nextSegment-1
+    uint32_t nextSegment;
+    uint32_t readPosition;           // Records already replayed from oldestSegment
+    uint32_t logRecords;             // Not yet replayed, all segments
+    uint16_t appendRecords;          // In segment nextSegment-1 ...
+    bool appendOpen;                 // ... when it can take more (same boot, not full)
+    
+    Source peekSource;
+    TelemetryStoreStats stats;
+    
+    void scanSegments(uint32_t cursorSegment, uint32_t cursorPosition);
+    uint16_t append(const TelemetryRecord* records, uint16_t count);
+    bool startSegment();
+    void dropOldestSegment();
+    void removeOldestSegment();
+    uint32_t countRecords(uint32_t segment, uint32_t* segmentBoot);
+    void saveCursor();
+};
+
+#endif // TELEMETRY_STORE_H
@@ -7,39 +7,73 @@
 #define TURBIDITY_SENSOR_H
 
 #include <Arduino.h>
+#include "config.h"
+#include "adc_sampler.h"
+#include "robust_filter.h"
+#include "sensor_snapshot.h"
 
+// Samples arrive continuously from an ADCSampler and are averaged into
+// blocks of TURBIDITY_BLOCK_MS; each finished block produces one reading
+// (voltage, filtered voltage, NTU, quality class, timestamp). getReading()
+// returns it as is, so it costs nothing and never touches the ADC.
 class TurbiditySensor {
 public:
     // Constructor
     TurbiditySensor(uint8_t pin);
     
+    // Optional, call before init() (default: continuous ADC on the ESP32,
+    // a synthetic waveform following the pin level on the host)
+    void setSampler(ADCSampler* adcSampler);
+    
     // Initialization
     bool init();
     
-    // Read sensor data
-    float readNTU();           // Read turbidity in NTU (Nephelometric Turbidity Units)
-    int readRawValue();        // Read raw analog value (0-4095)
-    float readVoltage();       // Read voltage (0-3.3V)
-    float readStableVoltage(); // Read voltage with moving average filter
-    String getWaterQuality();  // Get qualitative assessment
+    // Drain new samples into blocks; call every loop
+    void update();
+    
+    // Reading from the last finished block (not valid before the first one)
+    TurbidityReading getReading();
+    int readRawValue();        // Last block's mean raw value (0-4095)
+    uint32_t getBlockCount();  // Blocks finished since init()
+    
+    // Filter window in blocks (1..RobustFilter::MAX_WINDOW), restarts the average
+    void setFilterWindow(uint16_t blocks);
+    uint16_t getFilterWindow();
     
     // Calibration
     void calibrate(float clearWaterVoltage, float dirtyWaterVoltage);
     
 private:
+    static const int SAMPLE_CHUNK = 64;  // Samples copied out of the sampler per read()
+    
     uint8_t sensorPin;
     float clearWaterVoltage;   // Voltage reading in clear water
     float dirtyWaterVoltage;   // Voltage reading in dirty water
     
-    // Moving average filter
-    static const int FILTER_SIZE = 20;
-    float voltageBuffer[FILTER_SIZE];
-    int bufferIndex;
-    bool bufferFilled;
+    // Sampling backend
+#ifdef ESP32
+    ContinuousADCSampler defaultSampler;
+#else
+    SyntheticADCSampler defaultSampler;
+#endif
+    ADCSampler* sampler = &defaultSampler;
+    bool samplerRunning;
+    uint32_t blockSamples;     // Samples per block
+    uint32_t blockSum;
+    uint32_t blockFill;
+    uint32_t blockCount;
+    
+    // Latest results
+    uint16_t lastRaw;
+    TurbidityReading reading;
+    
+    // Moving average over the blocks with spike rejection
+    RobustFilter voltageFilter;
+    
+    void finishBlock();
     
     // Convert voltage to NTU
     float voltageToNTU(float voltage);
-    float getAverageVoltage();
 };
 
 #endif // TURBIDITY_SENSOR_H
@@ -0,0 +1,76 @@
+/**
+ * @file window_aggregator.h
+ * @brief Streaming min/max/mean/stddev of every snapshot between two publishes
+ */
+
+#ifndef WINDOW_AGGREGATOR_H
+#define WINDOW_AGGREGATOR_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "sensor_snapshot.h"
+
+// Summary of one metric over a window
+struct MetricSummary {
+    uint32_t count;          // Valid readings; the rest are 0 when count is 0
+    float min;
+    float max;
+    float mean;
+    float stddev;            // Population standard deviation
+    float last;
+};
+
+// Running statistics in O(1) memory and time per value (Welford's update,
+// which stays accurate where a sum of squares in float would cancel out)
+class RunningStats {
+public:
+    RunningStats();
+    void reset();
+    void add(float value);
+    uint32_t getCount();
+    MetricSummary summarize();
+    
+private:
+    uint32_t count;
+    float mean;
+    float m2;                // Sum of squared deviations from the mean
+    float min;
+    float max;
+    float last;
+};
+
+// Everything measured between two publishes
+struct TelemetrySummary {
+    unsigned long startMs;   // First snapshot in the window
+    unsigned long endMs;     // Last snapshot in the window
+    uint32_t snapshots;
+    uint8_t temperatureCount;
+    MetricSummary temperatures[DS18B20_MAX_PROBES];
+    MetricSummary turbidity;
+    MetricSummary ph;
+};
+
+// Every snapshot is added; the window is summarised when a message is due
+// and reset once its summary is handed off - published, queued into a batch
+// or stored for replay - so no reading is discarded and a short spike still
+// shows up in max even when it fell between two messages.
+class WindowAggregator {
+public:
+    WindowAggregator();
+    
+    void add(const SensorSnapshot& snapshot);   // Invalid readings are skipped
+    TelemetrySummary summarize();
+    void reset();                               // Start the next window
+    uint32_t getSnapshotCount();
+    
+private:
+    unsigned long startMs;
+    unsigned long endMs;
+    uint32_t snapshots;
+    uint8_t temperatureCount;
+    RunningStats temperatures[DS18B20_MAX_PROBES];
+    RunningStats turbidity;
+    RunningStats ph;
+};
+
+#endif // WINDOW_AGGREGATOR_H
@@ -0,0 +1,32 @@
+/**
+ * @file Adafruit_GFX.h
+ * @brief Graphics base stand-in for the native build (text calls only)
+ */
+
+#ifndef NATIVE_ADAFRUIT_GFX_H
+#define NATIVE_ADAFRUIT_GFX_H
+
+#include "Arduino.h"
+
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : width(w), height(h) {}
+
+    void setTextSize(uint8_t size) {}
+    void setTextColor(uint16_t color) {}
+    void setTextColor(uint16_t color, uint16_t background) {}
+    void setCursor(int16_t x, int16_t y) {}
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {}
+    void fillScreen(uint16_t color) {}
+    int16_t getWidth() { return width; }
+    int16_t getHeight() { return height; }
+
+    size_t write(uint8_t c) override { return 1; }
+    using Print::write;
+
+protected:
+    int16_t width;
+    int16_t height;
+};
+
+#endif // NATIVE_ADAFRUIT_GFX_H
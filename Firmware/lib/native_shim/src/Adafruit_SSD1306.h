@@ -0,0 +1,29 @@
+/**
+ * @file Adafruit_SSD1306.h
+ * @brief OLED driver stand-in for the native build (drawing is discarded)
+ */
+
+#ifndef NATIVE_ADAFRUIT_SSD1306_H
+#define NATIVE_ADAFRUIT_SSD1306_H
+
+#include "Adafruit_GFX.h"
+#include "Wire.h"
+
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_INVERSE 2
+#define SSD1306_EXTERNALVCC 0x01
+#define SSD1306_SWITCHCAPVCC 0x02
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+public:
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi = &Wire, int8_t rstPin = -1)
+        : Adafruit_GFX(w, h) {}
+
+    bool begin(uint8_t switchVcc = SSD1306_SWITCHCAPVCC, uint8_t i2cAddr = 0,
+               bool reset = true, bool periphBegin = true) { return true; }
+    void clearDisplay() {}
+    void display() {}
+};
+
+#endif // NATIVE_ADAFRUIT_SSD1306_H
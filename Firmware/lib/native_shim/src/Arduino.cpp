@@ -0,0 +1,107 @@
+/**
+ * @file Arduino.cpp
+ * @brief Minimal Arduino core stand-in implementation
+ */
+
+#include <stdio.h>
+#include "Arduino.h"
+
+HardwareSerial Serial;
+HardwareSerial Serial1;
+
+// ==================== Timing ====================
+unsigned long millis() {
+    return (unsigned long)(NativeHW::nowMicros() / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)NativeHW::nowMicros();
+}
+
+void delay(unsigned long ms) {
+    NativeHW::advanceMillis(ms);
+}
+
+void delayMicroseconds(unsigned int us) {
+    NativeHW::advanceMicros(us);
+}
+
+void yield() {}
+
+// ==================== Random ====================
+// xorshift32 so host runs are reproducible for a given randomSeed(). One
+// state per thread: the sensor thread draws without racing loop(), and its
+// sequence does not depend on how the two interleave.
+static thread_local uint32_t randomState = 0x12345678;
+
+static uint32_t nextRandom() {
+    uint32_t x = randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    randomState = x;
+    return x;
+}
+
+long random(long howbig) {
+    if (howbig <= 0) {
+        return 0;
+    }
+    return nextRandom() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) {
+        return howsmall;
+    }
+    return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) {
+    randomState = seed ? (uint32_t)seed : 0x12345678;
+}
+
+// ==================== GPIO / ADC ====================
+void pinMode(uint8_t pin, uint8_t mode) {}
+
+int digitalRead(uint8_t pin) {
+    return LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {}
+
+uint16_t analogRead(uint8_t pin) {
+    // 12-bit over the 0-3.3V range (11 dB attenuation)
+    uint32_t raw = NativeHW::getAnalogMilliVolts(pin) * 4095 / 3300;
+    return raw > 4095 ? 4095 : raw;
+}
+
+uint32_t analogReadMilliVolts(uint8_t pin) {
+    return NativeHW::getAnalogMilliVolts(pin);
+}
+
+void analogReadResolution(uint8_t bits) {}
+void analogSetAttenuation(adc_attenuation_t attenuation) {}
+void analogSetPinAttenuation(uint8_t pin, adc_attenuation_t attenuation) {}
+
+// ==================== Time (NTP) ====================
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1,
+                const char* server2, const char* server3) {}
+
+// Replaces the C library's time() for the whole program, so effects and
+// setupNTP() see the virtual wall clock instead of the host's
+extern "C" time_t time(time_t* out) {
+    time_t now = NativeHW::wallClock();
+    if (out != nullptr) {
+        *out = now;
+    }
+    return now;
+}
+
+// ==================== Serial ====================
+size_t HardwareSerial::write(uint8_t c) {
+    if (NativeHW::isSerialEcho()) {
+        putchar(c);
+    }
+    return 1;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file Arduino.h
+ * @brief Minimal Arduino core stand-in for the native (host) build
+ *
+ * Time comes from the virtual clock in native_hw.h: delay() advances it
+ * instead of sleeping, so a simulated hour runs in milliseconds.
+ */
+
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+
+#include "WString.h"
+#include "Print.h"
+#include "native_hw.h"
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define SERIAL_8N1 0x800001c
+
+using std::min;
+using std::max;
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// ==================== Timing ====================
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// ==================== Random ====================
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// ==================== GPIO / ADC ====================
+enum adc_attenuation_t { ADC_0db, ADC_2_5db, ADC_6db, ADC_11db };
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t val);
+uint16_t analogRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+void analogReadResolution(uint8_t bits);
+void analogSetAttenuation(adc_attenuation_t attenuation);
+void analogSetPinAttenuation(uint8_t pin, adc_attenuation_t attenuation);
+
+// ==================== Time (NTP) ====================
+// "Synchronized" from the start: time() is the virtual wall clock
+// (NativeHW::wallClock()), defined in Arduino.cpp in place of the C library's
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1,
+                const char* server2 = nullptr, const char* server3 = nullptr);
+
+// ==================== Serial ====================
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1) {}
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t write(uint8_t c) override;
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+
+// Sketch entry points (main.cpp)
+void setup();
+void loop();
+
+#endif // NATIVE_ARDUINO_H
@@ -0,0 +1,135 @@
+/**
+ * @file DallasTemperature.h
+ * @brief DS18B20 driver stand-in for the native build
+ *
+ * Up to NativeHW::MAX_TEMPERATURE_PROBES probes, probe p reporting
+ * NativeHW::getTemperatureC(p) under ROM 28-(p+1)-02-03-04-05-06-crc.
+ * Conversions take the datasheet time for the configured resolution on the
+ * virtual clock: with waitForConversion (the default) requestTemperatures()
+ * advances the clock like the real blocking call, otherwise
+ * isConversionComplete() turns true once the time has passed.
+ *
+ * Like the real library, begin() and getAddress() search the bus (counted
+ * in NativeHW::getBusSearchCount()) while getDeviceCount() returns the count
+ * from begin() and getTempC() addresses one probe directly.
+ */
+
+#ifndef NATIVE_DALLAS_TEMPERATURE_H
+#define NATIVE_DALLAS_TEMPERATURE_H
+
+#include "Arduino.h"
+#include "OneWire.h"
+
+#define DEVICE_DISCONNECTED_C -127
+#define DEVICE_DISCONNECTED_F -196.6
+#define DEVICE_DISCONNECTED_RAW -7040
+
+typedef uint8_t DeviceAddress[8];
+
+class DallasTemperature {
+public:
+    DallasTemperature(OneWire* bus) {}
+
+    void begin();
+    uint8_t getDeviceCount() { return devices; }
+    bool getAddress(uint8_t* address, uint8_t index);
+    bool validAddress(const uint8_t* address) { return OneWire::crc8(address, 7) == address[7]; }
+    bool validFamily(const uint8_t* address) { return address[0] == 0x28 || address[0] == 0x10 || address[0] == 0x22; }
+    bool isConnected(const uint8_t* address) { return probeFor(address) >= 0; }
+
+    void setResolution(uint8_t newResolution) { resolution = constrain(newResolution, 9, 12); }
+    uint8_t getResolution() { return resolution; }
+    void setWaitForConversion(bool wait) { waitForConversion = wait; }
+    bool getWaitForConversion() { return waitForConversion; }
+    int16_t millisToWaitForConversion(uint8_t bits) { return 750 / (1 << (12 - constrain(bits, 9, 12))); }
+    int16_t millisToWaitForConversion() { return millisToWaitForConversion(resolution); }
+
+    void requestTemperatures();
+    bool requestTemperaturesByAddress(const uint8_t* address) { requestTemperatures(); return isConnected(address); }
+    bool isConversionComplete();
+
+    float getTempCByIndex(uint8_t index);
+    float getTempC(const uint8_t* address);
+
+private:
+    uint8_t devices = 0;
+    uint8_t resolution = 12;
+    bool waitForConversion = true;
+    unsigned long conversionStartMs = 0;
+    float latched[NativeHW::MAX_TEMPERATURE_PROBES];
+
+    static bool isPresent(uint8_t probe) { return NativeHW::getTemperatureC(probe) != DEVICE_DISCONNECTED_C; }
+    static void romFor(uint8_t probe, uint8_t* address);
+    int probeFor(const uint8_t* address);   // -1 when no such probe answers
+};
+
+inline void DallasTemperature::romFor(uint8_t probe, uint8_t* address) {
+    static const uint8_t rom[7] = {0x28, 0x00, 0x02, 0x03, 0x04, 0x05, 0x06};
+    memcpy(address, rom, sizeof(rom));
+    address[1] = probe + 1;
+    address[7] = OneWire::crc8(address, 7);
+}
+
+inline int DallasTemperature::probeFor(const uint8_t* address) {
+    uint8_t rom[8];
+    uint8_t probe = address[1] - 1;
+    if (probe >= NativeHW::MAX_TEMPERATURE_PROBES || !isPresent(probe)) {
+        return -1;
+    }
+    romFor(probe, rom);
+    return memcmp(rom, address, sizeof(rom)) == 0 ? probe : -1;
+}
+
+inline void DallasTemperature::begin() {
+    NativeHW::countBusSearch();
+    devices = 0;
+    for (uint8_t p = 0; p < NativeHW::MAX_TEMPERATURE_PROBES; p++) {
+        latched[p] = DEVICE_DISCONNECTED_C;
+        if (isPresent(p)) devices++;
+    }
+}
+
+inline bool DallasTemperature::getAddress(uint8_t* address, uint8_t index) {
+    NativeHW::countBusSearch();
+    for (uint8_t p = 0; p < NativeHW::MAX_TEMPERATURE_PROBES; p++) {
+        if (isPresent(p) && index-- == 0) {
+            romFor(p, address);
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void DallasTemperature::requestTemperatures() {
+    conversionStartMs = millis();
+    if (waitForConversion) {
+        delay(millisToWaitForConversion());
+    }
+}
+
+inline bool DallasTemperature::isConversionComplete() {
+    return millis() - conversionStartMs >= (unsigned long)millisToWaitForConversion();
+}
+
+inline float DallasTemperature::getTempCByIndex(uint8_t index) {
+    DeviceAddress address;
+    if (!getAddress(address, index)) {
+        return DEVICE_DISCONNECTED_C;
+    }
+    return getTempC(address);
+}
+
+inline float DallasTemperature::getTempC(const uint8_t* address) {
+    int probe = probeFor(address);
+    if (probe < 0) {
+        return DEVICE_DISCONNECTED_C;
+    }
+    // The scratchpad holds the last finished conversion, quantised to the resolution
+    if (isConversionComplete()) {
+        float step = 0.0625f * (1 << (12 - resolution));
+        latched[probe] = floorf(NativeHW::getTemperatureC(probe) / step) * step;
+    }
+    return latched[probe];
+}
+
+#endif // NATIVE_DALLAS_TEMPERATURE_H
@@ -0,0 +1,8 @@
+/**
+ * @file FastLED.cpp
+ * @brief FastLED stand-in globals
+ */
+
+#include "FastLED.h"
+
+CFastLED FastLED;
@@ -0,0 +1,122 @@
+/**
+ * @file FastLED.h
+ * @brief FastLED stand-in for the native build (CRGB + a recording controller)
+ */
+
+#ifndef NATIVE_FASTLED_H
+#define NATIVE_FASTLED_H
+
+#include "Arduino.h"
+
+typedef uint8_t fract8;
+
+// Scale i by scale/256 (FastLED semantics)
+static inline uint8_t scale8(uint8_t i, fract8 scale) {
+    return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8;
+}
+
+static inline uint8_t qadd8(uint8_t i, uint8_t j) {
+    unsigned int t = i + j;
+    return t > 255 ? 255 : t;
+}
+
+static inline uint8_t qsub8(uint8_t i, uint8_t j) {
+    return i > j ? i - j : 0;
+}
+
+struct CRGB {
+    union {
+        struct {
+            uint8_t r;
+            uint8_t g;
+            uint8_t b;
+        };
+        uint8_t raw[3];
+    };
+
+    CRGB() : r(0), g(0), b(0) {}
+    CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+    CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+
+    uint8_t& operator[](uint8_t x) { return raw[x]; }
+    const uint8_t& operator[](uint8_t x) const { return raw[x]; }
+
+    CRGB& operator+=(const CRGB& rhs) {
+        r = qadd8(r, rhs.r);
+        g = qadd8(g, rhs.g);
+        b = qadd8(b, rhs.b);
+        return *this;
+    }
+
+    CRGB& operator-=(const CRGB& rhs) {
+        r = qsub8(r, rhs.r);
+        g = qsub8(g, rhs.g);
+        b = qsub8(b, rhs.b);
+        return *this;
+    }
+
+    CRGB& nscale8(uint8_t scaledown) {
+        r = scale8(r, scaledown);
+        g = scale8(g, scaledown);
+        b = scale8(b, scaledown);
+        return *this;
+    }
+
+    CRGB& fadeToBlackBy(uint8_t fadefactor) {
+        return nscale8(255 - fadefactor);
+    }
+
+    bool operator==(const CRGB& rhs) const { return r == rhs.r && g == rhs.g && b == rhs.b; }
+    bool operator!=(const CRGB& rhs) const { return !(*this == rhs); }
+
+    enum HTMLColorCode {
+        Black = 0x000000,
+        White = 0xFFFFFF,
+        Red = 0xFF0000,
+        Green = 0x008000,
+        Blue = 0x0000FF
+    };
+};
+
+#define BINARY_DITHER 0x01
+#define DISABLE_DITHER 0x00
+
+enum EOrder { RGB = 0012, RBG = 0021, GRB = 0102, GBR = 0120, BRG = 0201, BGR = 0210 };
+
+template <uint8_t DATA_PIN, EOrder RGB_ORDER> class WS2812 {};
+template <uint8_t DATA_PIN, EOrder RGB_ORDER> class WS2812B {};
+
+class CFastLED {
+public:
+    template <template <uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+    void addLeds(CRGB* data, int nLedsOrOffset, int nLedsIfOffset = 0) {
+        leds = data;
+        numLeds = nLedsIfOffset > 0 ? nLedsIfOffset : nLedsOrOffset;
+    }
+
+    void setBrightness(uint8_t scale) { brightness = scale; }
+    void setDither(uint8_t ditherMode = BINARY_DITHER) {}
+    uint8_t getBrightness() { return brightness; }
+
+    void clear(bool writeData = false) {
+        for (int i = 0; i < numLeds; i++) leds[i] = CRGB(0, 0, 0);
+        if (writeData) show();
+    }
+
+    void show() { showCount++; }
+
+    // Host-side inspection
+    CRGB* getLeds() { return leds; }
+    int size() { return numLeds; }
+    uint32_t getShowCount() { return showCount; }
+
+private:
+    CRGB* leds = nullptr;
+    int numLeds = 0;
+    uint8_t brightness = 255;
+    uint32_t showCount = 0;
+};
+
+extern CFastLED FastLED;
+
+#endif // NATIVE_FASTLED_H
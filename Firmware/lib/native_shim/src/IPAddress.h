@@ -0,0 +1,26 @@
+/**
+ * @file IPAddress.h
+ * @brief IPAddress stand-in for the native build
+ */
+
+#ifndef NATIVE_IPADDRESS_H
+#define NATIVE_IPADDRESS_H
+
+#include "Print.h"
+
+class IPAddress : public Printable {
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : octets{a, b, c, d} {}
+
+    String toString() const {
+        return String((int)octets[0]) + "." + String((int)octets[1]) + "." +
+               String((int)octets[2]) + "." + String((int)octets[3]);
+    }
+
+    size_t printTo(Print& p) const override { return p.print(toString()); }
+
+private:
+    uint8_t octets[4];
+};
+
+#endif // NATIVE_IPADDRESS_H
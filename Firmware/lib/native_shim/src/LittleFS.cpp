@@ -0,0 +1,232 @@
+/**
+ * @file LittleFS.cpp
+ * @brief Directory-backed LittleFS stand-in implementation
+ */
+
+#include "LittleFS.h"
+#include <stdio.h>
+#include <algorithm>
+#include <filesystem>
+
+namespace stdfs = std::filesystem;
+
+LittleFSFS LittleFS;
+
+static std::string hostRoot = "native_fs";
+static size_t capacityBytes = 0x160000;   // Default esp32dev "spiffs" partition
+static bool mountFails = false;
+
+namespace fs {
+
+struct FileImpl {
+    std::string path;          // Path inside the filesystem ("/tlm/a.seg")
+    std::string name;
+    FILE* handle = nullptr;
+    bool directory = false;
+    std::vector<std::string> entries;   // Directory listing, sorted
+    size_t nextEntry = 0;
+    LittleFSFS* owner = nullptr;
+
+    ~FileImpl() {
+        if (handle) fclose(handle);
+    }
+};
+
+size_t File::write(const uint8_t* buf, size_t size) {
+    if (!impl || !impl->handle) return 0;
+    size_t used = impl->owner->usedBytes();
+    size_t total = impl->owner->totalBytes();
+    size_t room = used < total ? total - used : 0;
+    size_t written = fwrite(buf, 1, std::min(size, room), impl->handle);
+    fflush(impl->handle);
+    return written;
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+    if (!impl || !impl->handle) return 0;
+    return fread(buf, 1, size, impl->handle);
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::available() {
+    if (!impl || !impl->handle) return 0;
+    return (int)(size() - position());
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (!impl || !impl->handle) return false;
+    int whence = mode == SeekCur ? SEEK_CUR : mode == SeekEnd ? SEEK_END : SEEK_SET;
+    return fseek(impl->handle, pos, whence) == 0;
+}
+
+size_t File::position() {
+    if (!impl || !impl->handle) return 0;
+    long pos = ftell(impl->handle);
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() {
+    if (!impl || !impl->handle) return 0;
+    long pos = ftell(impl->handle);
+    fseek(impl->handle, 0, SEEK_END);
+    long end = ftell(impl->handle);
+    fseek(impl->handle, pos, SEEK_SET);
+    return end < 0 ? 0 : (size_t)end;
+}
+
+void File::flush() {
+    if (impl && impl->handle) fflush(impl->handle);
+}
+
+void File::close() {
+    impl.reset();
+}
+
+File::operator bool() const {
+    return impl && (impl->handle || impl->directory);
+}
+
+const char* File::name() const {
+    return impl ? impl->name.c_str() : "";
+}
+
+const char* File::path() const {
+    return impl ? impl->path.c_str() : "";
+}
+
+bool File::isDirectory() {
+    return impl && impl->directory;
+}
+
+File File::openNextFile(const char* mode) {
+    if (!impl || !impl->directory || impl->nextEntry >= impl->entries.size()) {
+        return File();
+    }
+    std::string child = impl->path == "/" ? "/" : impl->path + "/";
+    child += impl->entries[impl->nextEntry++];
+    return impl->owner->open(child.c_str(), mode);
+}
+
+void File::rewindDirectory() {
+    if (impl) impl->nextEntry = 0;
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles,
+                       const char* partitionLabel) {
+    if (mountFails) return false;
+    std::error_code error;
+    stdfs::create_directories(hostRoot, error);
+    mounted = stdfs::is_directory(hostRoot, error);
+    return mounted;
+}
+
+void LittleFSFS::end() {
+    mounted = false;
+}
+
+bool LittleFSFS::format() {
+    std::error_code error;
+    stdfs::remove_all(hostRoot, error);
+    stdfs::create_directories(hostRoot, error);
+    return !error;
+}
+
+std::string LittleFSFS::hostPath(const char* path) {
+    std::string inside = path ? path : "/";
+    if (inside.empty() || inside[0] != '/') inside = "/" + inside;
+    return hostRoot + inside;
+}
+
+File LittleFSFS::open(const char* path, const char* mode, bool create) {
+    if (!mounted || !path) return File();
+
+    auto impl = std::make_shared<FileImpl>();
+    impl->owner = this;
+    impl->path = path;
+    impl->name = stdfs::path(impl->path).filename().string();
+    std::string host = hostPath(path);
+    std::error_code error;
+
+    if (stdfs::is_directory(host, error)) {
+        if (strcmp(mode, FILE_READ) != 0) return File();
+        impl->directory = true;
+        for (const auto& entry : stdfs::directory_iterator(host, error)) {
+            impl->entries.push_back(entry.path().filename().string());
+        }
+        std::sort(impl->entries.begin(), impl->entries.end());
+        return File(impl);
+    }
+
+    if (strcmp(mode, FILE_READ) != 0 && create) {
+        stdfs::create_directories(stdfs::path(host).parent_path(), error);
+    }
+    std::string hostMode = std::string(mode) + "b";
+    impl->handle = fopen(host.c_str(), hostMode.c_str());
+    if (!impl->handle) return File();
+    return File(impl);
+}
+
+bool LittleFSFS::exists(const char* path) {
+    std::error_code error;
+    return mounted && stdfs::exists(hostPath(path), error);
+}
+
+bool LittleFSFS::remove(const char* path) {
+    std::error_code error;
+    return mounted && stdfs::is_regular_file(hostPath(path), error) &&
+           stdfs::remove(hostPath(path), error);
+}
+
+bool LittleFSFS::rename(const char* from, const char* to) {
+    std::error_code error;
+    if (!mounted) return false;
+    stdfs::rename(hostPath(from), hostPath(to), error);
+    return !error;
+}
+
+bool LittleFSFS::mkdir(const char* path) {
+    std::error_code error;
+    if (!mounted) return false;
+    stdfs::create_directory(hostPath(path), error);
+    return stdfs::is_directory(hostPath(path), error);
+}
+
+bool LittleFSFS::rmdir(const char* path) {
+    std::error_code error;
+    return mounted && stdfs::remove(hostPath(path), error);
+}
+
+size_t LittleFSFS::totalBytes() {
+    return capacityBytes;
+}
+
+size_t LittleFSFS::usedBytes() {
+    std::error_code error;
+    size_t used = 0;
+    for (const auto& entry : stdfs::recursive_directory_iterator(hostRoot, error)) {
+        if (entry.is_regular_file(error)) used += entry.file_size(error);
+    }
+    return used;
+}
+
+void LittleFSFS::setHostRoot(const char* directory) {
+    hostRoot = directory;
+}
+
+const char* LittleFSFS::getHostRoot() {
+    return hostRoot.c_str();
+}
+
+void LittleFSFS::setCapacity(size_t bytes) {
+    capacityBytes = bytes;
+}
+
+void LittleFSFS::setMountFails(bool fails) {
+    mountFails = fails;
+}
+
+}  // namespace fs
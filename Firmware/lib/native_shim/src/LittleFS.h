@@ -0,0 +1,93 @@
+/**
+ * @file LittleFS.h
+ * @brief LittleFS stand-in for the native build, backed by a host directory
+ *
+ * Paths map to files under the host root ("native_fs" unless
+ * setHostRoot() picks another), so stored data survives a simulated reboot
+ * and can be inspected with ordinary tools. setCapacity() bounds totalBytes() so a
+ * full flash can be simulated: writes beyond it are short.
+ */
+
+#ifndef NATIVE_LITTLEFS_H
+#define NATIVE_LITTLEFS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+namespace fs {
+
+struct FileImpl;
+
+class File {
+public:
+    File() {}
+    explicit File(std::shared_ptr<FileImpl> impl) : impl(impl) {}
+
+    size_t write(const uint8_t* buf, size_t size);
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t read(uint8_t* buf, size_t size);
+    int read();
+    int available();
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position();
+    size_t size();
+    void flush();
+    void close();
+    operator bool() const;
+    const char* name() const;   // Last path component, like the ESP32 core
+    const char* path() const;
+    bool isDirectory();
+    File openNextFile(const char* mode = FILE_READ);
+    void rewindDirectory();
+
+private:
+    std::shared_ptr<FileImpl> impl;
+};
+
+class LittleFSFS {
+public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+               uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+    void end();
+    bool format();
+    File open(const char* path, const char* mode = FILE_READ, bool create = false);
+    File open(const String& path, const char* mode = FILE_READ, bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* from, const char* to);
+    bool mkdir(const char* path);
+    bool rmdir(const char* path);
+    size_t totalBytes();
+    size_t usedBytes();
+
+    // Host-side helpers
+    static void setHostRoot(const char* directory);
+    static const char* getHostRoot();
+    static void setCapacity(size_t bytes);
+    static void setMountFails(bool fails);   // begin() returns false
+
+private:
+    bool mounted = false;
+    std::string hostPath(const char* path);
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::LittleFSFS;
+
+extern LittleFSFS LittleFS;
+
+#endif // NATIVE_LITTLEFS_H
@@ -0,0 +1,36 @@
+/**
+ * @file OneWire.h
+ * @brief OneWire bus stand-in for the native build (the bus itself is
+ *        simulated inside DallasTemperature.h)
+ */
+
+#ifndef NATIVE_ONEWIRE_H
+#define NATIVE_ONEWIRE_H
+
+#include "Arduino.h"
+
+class OneWire {
+public:
+    OneWire(uint8_t pin) : pin(pin) {}
+    uint8_t getPin() { return pin; }
+
+    // Dallas/Maxim CRC-8 (last byte of every ROM code)
+    static uint8_t crc8(const uint8_t* data, uint8_t len) {
+        uint8_t crc = 0;
+        while (len--) {
+            uint8_t byte = *data++;
+            for (uint8_t i = 0; i < 8; i++) {
+                uint8_t mix = (crc ^ byte) & 0x01;
+                crc >>= 1;
+                if (mix) crc ^= 0x8C;
+                byte >>= 1;
+            }
+        }
+        return crc;
+    }
+
+private:
+    uint8_t pin;
+};
+
+#endif // NATIVE_ONEWIRE_H
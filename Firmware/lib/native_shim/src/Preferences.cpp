@@ -0,0 +1,95 @@
+/**
+ * @file Preferences.cpp
+ * @brief In-memory Preferences stand-in (shared across instances like real NVS)
+ */
+
+#include "Preferences.h"
+
+static std::map<std::string, std::vector<uint8_t>>& store() {
+    static std::map<std::string, std::vector<uint8_t>> values;
+    return values;
+}
+
+bool Preferences::begin(const char* name, bool readOnly) {
+    ns = name ? name : "";
+    return true;
+}
+
+bool Preferences::clear() {
+    std::string prefix = ns + "/";
+    auto& values = store();
+    for (auto it = values.begin(); it != values.end();) {
+        if (it->first.compare(0, prefix.size(), prefix) == 0) {
+            it = values.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    return store().erase(keyFor(key)) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+    return has(key);
+}
+
+bool Preferences::has(const char* key) {
+    return store().count(keyFor(key)) > 0;
+}
+
+std::vector<uint8_t>& Preferences::slot(const char* key) {
+    return store()[keyFor(key)];
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)value;
+    slot(key).assign(bytes, bytes + len);
+    return len;
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+    if (!has(key)) {
+        return 0;
+    }
+    std::vector<uint8_t>& bytes = slot(key);
+    size_t len = bytes.size() < maxLen ? bytes.size() : maxLen;
+    memcpy(buf, bytes.data(), len);
+    return len;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    return has(key) ? slot(key).size() : 0;
+}
+
+size_t Preferences::putString(const char* key, const String& value) {
+    return putBytes(key, value.c_str(), value.length() + 1);
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+    if (!has(key)) {
+        return defaultValue;
+    }
+    return String((const char*)slot(key).data());
+}
+
+// Fixed-size values are stored as raw bytes
+#define NATIVE_PREF_SCALAR(Name, Type)                                  \
+    size_t Preferences::put##Name(const char* key, Type value) {        \
+        return putBytes(key, &value, sizeof(value));                    \
+    }                                                                   \
+    Type Preferences::get##Name(const char* key, Type defaultValue) {   \
+        Type value = defaultValue;                                      \
+        if (getBytesLength(key) == sizeof(Type)) {                      \
+            getBytes(key, &value, sizeof(value));                       \
+        }                                                               \
+        return value;                                                   \
+    }
+
+NATIVE_PREF_SCALAR(UInt, uint32_t)
+NATIVE_PREF_SCALAR(Int, int32_t)
+NATIVE_PREF_SCALAR(UChar, uint8_t)
+NATIVE_PREF_SCALAR(Float, float)
+NATIVE_PREF_SCALAR(Bool, bool)
@@ -0,0 +1,45 @@
+/**
+ * @file Preferences.h
+ * @brief ESP32 Preferences (NVS) stand-in for the native build, kept in memory
+ */
+
+#ifndef NATIVE_PREFERENCES_H
+#define NATIVE_PREFERENCES_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false);
+    void end() {}
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+
+    size_t putString(const char* key, const String& value);
+    String getString(const char* key, const String& defaultValue = String());
+    size_t putUInt(const char* key, uint32_t value);
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+    size_t putInt(const char* key, int32_t value);
+    int32_t getInt(const char* key, int32_t defaultValue = 0);
+    size_t putUChar(const char* key, uint8_t value);
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0);
+    size_t putFloat(const char* key, float value);
+    float getFloat(const char* key, float defaultValue = 0);
+    size_t putBool(const char* key, bool value);
+    bool getBool(const char* key, bool defaultValue = false);
+    size_t putBytes(const char* key, const void* value, size_t len);
+    size_t getBytes(const char* key, void* buf, size_t maxLen);
+    size_t getBytesLength(const char* key);
+
+private:
+    std::string ns;
+    std::string keyFor(const char* key) { return ns + "/" + key; }
+    bool has(const char* key);
+    std::vector<uint8_t>& slot(const char* key);
+};
+
+#endif // NATIVE_PREFERENCES_H
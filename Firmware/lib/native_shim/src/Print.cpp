@@ -0,0 +1,41 @@
+/**
+ * @file Print.cpp
+ * @brief Arduino Print stand-in implementation
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "Print.h"
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::write(const char* s) {
+    return s ? write((const uint8_t*)s, strlen(s)) : 0;
+}
+
+size_t Print::print(const __FlashStringHelper* s) { return write(reinterpret_cast<const char*>(s)); }
+size_t Print::print(const String& s) { return write(s.c_str()); }
+size_t Print::print(const char* s) { return write(s); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char v, int base) { return print(String(v, base)); }
+size_t Print::print(int v, int base) { return print(String(v, base)); }
+size_t Print::print(unsigned int v, int base) { return print(String(v, base)); }
+size_t Print::print(long v, int base) { return print(String(v, base)); }
+size_t Print::print(unsigned long v, int base) { return print(String(v, base)); }
+size_t Print::print(double v, int digits) { return print(String(v, digits)); }
+size_t Print::print(const Printable& p) { return p.printTo(*this); }
+size_t Print::println() { return write("\r\n"); }
+
+size_t Print::printf(const char* format, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    return len > 0 ? write(buf) : 0;
+}
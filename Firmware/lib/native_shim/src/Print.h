@@ -0,0 +1,50 @@
+/**
+ * @file Print.h
+ * @brief Arduino Print stand-in for the native build
+ */
+
+#ifndef NATIVE_PRINT_H
+#define NATIVE_PRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+
+class Print;
+
+// Anything that can print itself (IPAddress)
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* s);
+
+    size_t print(const __FlashStringHelper* s);
+    size_t print(const String& s);
+    size_t print(const char* s);
+    size_t print(char c);
+    size_t print(unsigned char v, int base = DEC);
+    size_t print(int v, int base = DEC);
+    size_t print(unsigned int v, int base = DEC);
+    size_t print(long v, int base = DEC);
+    size_t print(unsigned long v, int base = DEC);
+    size_t print(double v, int digits = 2);
+    size_t print(const Printable& p);
+
+    size_t println();
+    template <typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(const T& v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+    size_t printf(const char* format, ...);
+};
+
+#endif // NATIVE_PRINT_H
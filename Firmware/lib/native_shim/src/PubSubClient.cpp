@@ -0,0 +1,55 @@
+/**
+ * @file PubSubClient.cpp
+ * @brief MQTT client stand-in implementation
+ */
+
+#include "PubSubClient.h"
+
+static MQTTPublishHook publishHook = nullptr;
+
+void PubSubClient::setPublishHook(MQTTPublishHook hook) {
+    publishHook = hook;
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass) {
+    NativeHW::advanceMillis(NativeHW::getBrokerConnectMs());   // Blocks like the real handshake
+    if (NativeHW::isWiFiConnected() && NativeHW::isBrokerReachable()) {
+        connectionState = MQTT_CONNECTED;
+        return true;
+    }
+    connectionState = MQTT_CONNECT_FAILED;
+    return false;
+}
+
+void PubSubClient::disconnect() {
+    connectionState = MQTT_DISCONNECTED;
+}
+
+bool PubSubClient::connected() {
+    if (connectionState == MQTT_CONNECTED &&
+        (!NativeHW::isWiFiConnected() || !NativeHW::isBrokerReachable())) {
+        connectionState = MQTT_CONNECTION_LOST;
+    }
+    return connectionState == MQTT_CONNECTED;
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload, bool retained) {
+    return publish(topic, (const uint8_t*)payload, payload ? strlen(payload) : 0, retained);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained) {
+    if (!connected() || length > bufferSize) {
+        return false;
+    }
+    publishCount++;
+    if (publishHook) {
+        publishHook(topic, payload, length, retained);
+    }
+    return true;
+}
+
+void PubSubClient::inject(const char* topic, const char* payload) {
+    if (callback) {
+        callback((char*)topic, (uint8_t*)payload, strlen(payload));
+    }
+}
@@ -0,0 +1,64 @@
+/**
+ * @file PubSubClient.h
+ * @brief MQTT client stand-in for the native build
+ *
+ * connect() succeeds while NativeHW::isBrokerReachable() and takes
+ * NativeHW::getBrokerConnectMs() of virtual time; publishes are
+ * counted and handed to an optional hook so host drivers can inspect them.
+ * inject() delivers a message to the registered callback as if it came
+ * from the broker.
+ */
+
+#ifndef NATIVE_PUBSUBCLIENT_H
+#define NATIVE_PUBSUBCLIENT_H
+
+#include "Arduino.h"
+#include "WiFiClientSecure.h"
+
+#define MQTT_CONNECTION_TIMEOUT -4
+#define MQTT_CONNECTION_LOST -3
+#define MQTT_CONNECT_FAILED -2
+#define MQTT_DISCONNECTED -1
+#define MQTT_CONNECTED 0
+
+typedef void (*MQTTPublishHook)(const char* topic, const uint8_t* payload, unsigned int length, bool retained);
+
+class PubSubClient {
+public:
+    typedef void (*Callback)(char*, uint8_t*, unsigned int);
+
+    PubSubClient() {}
+    PubSubClient(WiFiClient& client) {}
+
+    PubSubClient& setServer(const char* domain, uint16_t port) { return *this; }
+    PubSubClient& setCallback(Callback cb) { callback = cb; return *this; }
+    PubSubClient& setClient(WiFiClient& client) { return *this; }
+    PubSubClient& setKeepAlive(uint16_t keepAlive) { return *this; }
+    PubSubClient& setSocketTimeout(uint16_t timeout) { return *this; }
+    bool setBufferSize(uint16_t size) { bufferSize = size; return true; }
+    uint16_t getBufferSize() { return bufferSize; }
+
+    bool connect(const char* id, const char* user, const char* pass);
+    void disconnect();
+    bool connected();
+    int state() { return connectionState; }
+    bool loop() { return connected(); }
+
+    bool publish(const char* topic, const char* payload, bool retained = false);
+    bool publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained = false);
+    bool subscribe(const char* topic, uint8_t qos = 0) { return connected(); }
+    bool unsubscribe(const char* topic) { return connected(); }
+
+    // Host-side helpers
+    static void setPublishHook(MQTTPublishHook hook);
+    uint32_t getPublishCount() { return publishCount; }
+    void inject(const char* topic, const char* payload);
+
+private:
+    Callback callback = nullptr;
+    uint16_t bufferSize = 256;
+    int connectionState = MQTT_DISCONNECTED;
+    uint32_t publishCount = 0;
+};
+
+#endif // NATIVE_PUBSUBCLIENT_H
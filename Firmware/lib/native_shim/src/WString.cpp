@@ -0,0 +1,35 @@
+/**
+ * @file WString.cpp
+ * @brief Arduino String stand-in implementation
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "WString.h"
+
+static std::string toBase(unsigned long v, unsigned char base) {
+    if (base < 2 || base > 36) base = 10;
+    if (v == 0) return "0";
+    std::string out;
+    while (v > 0) {
+        out.insert(out.begin(), "0123456789abcdefghijklmnopqrstuvwxyz"[v % base]);
+        v /= base;
+    }
+    return out;
+}
+
+String::String(long v, unsigned char base) {
+    if (v < 0 && base == 10) {
+        str = "-" + toBase((unsigned long)(-v), base);
+    } else {
+        str = toBase((unsigned long)v, base);
+    }
+}
+
+String::String(unsigned long v, unsigned char base) : str(toBase(v, base)) {}
+
+String::String(double v, unsigned char decimals) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    str = buf;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file WString.h
+ * @brief Arduino String stand-in for the native build (backed by std::string)
+ */
+
+#ifndef NATIVE_WSTRING_H
+#define NATIVE_WSTRING_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+class String {
+public:
+    String() {}
+    String(const char* s) : str(s ? s : "") {}
+    String(const std::string& s) : str(s) {}
+    String(char c) : str(1, c) {}
+    String(unsigned char v, unsigned char base = 10) : String((unsigned long)v, base) {}
+    String(int v, unsigned char base = 10) : String((long)v, base) {}
+    String(unsigned int v, unsigned char base = 10) : String((unsigned long)v, base) {}
+    String(long v, unsigned char base = 10);
+    String(unsigned long v, unsigned char base = 10);
+    String(float v, unsigned char decimals = 2) : String((double)v, decimals) {}
+    String(double v, unsigned char decimals = 2);
+
+    const char* c_str() const { return str.c_str(); }
+    unsigned int length() const { return str.length(); }
+    bool reserve(unsigned int size) { str.reserve(size); return true; }
+    bool concat(const String& s) { str += s.str; return true; }
+    bool concat(const char* s) { if (s) str += s; return true; }
+    bool concat(char c) { str += c; return true; }
+    bool concat(const char* s, unsigned int n) { str.append(s, n); return true; }
+    int indexOf(char c) const { size_t p = str.find(c); return p == std::string::npos ? -1 : (int)p; }
+    String substring(unsigned int from) const { return String(str.substr(from)); }
+    String substring(unsigned int from, unsigned int to) const { return String(str.substr(from, to - from)); }
+    int toInt() const { return atoi(str.c_str()); }
+    float toFloat() const { return (float)atof(str.c_str()); }
+    char operator[](unsigned int i) const { return str[i]; }
+
+    String& operator+=(const String& s) { str += s.str; return *this; }
+    String& operator+=(const char* s) { if (s) str += s; return *this; }
+    String& operator+=(char c) { str += c; return *this; }
+    bool operator==(const String& s) const { return str == s.str; }
+    bool operator==(const char* s) const { return str == (s ? s : ""); }
+    bool operator!=(const String& s) const { return str != s.str; }
+    bool operator!=(const char* s) const { return !(*this == s); }
+    bool operator<(const String& s) const { return str < s.str; }
+
+    friend String operator+(const String& a, const String& b) { return String(a.str + b.str); }
+    friend String operator+(const String& a, const char* b) { return String(a.str + (b ? b : "")); }
+    friend String operator+(const char* a, const String& b) { return String((a ? a : "") + b.str); }
+
+private:
+    std::string str;
+};
+
+#endif // NATIVE_WSTRING_H
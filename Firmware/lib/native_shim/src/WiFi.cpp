@@ -0,0 +1,8 @@
+/**
+ * @file WiFi.cpp
+ * @brief ESP32 WiFi stand-in globals
+ */
+
+#include "WiFi.h"
+
+WiFiClass WiFi;
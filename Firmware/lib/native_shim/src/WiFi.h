@@ -0,0 +1,36 @@
+/**
+ * @file WiFi.h
+ * @brief ESP32 WiFi stand-in for the native build (driven by NativeHW::setWiFiConnected)
+ */
+
+#ifndef NATIVE_WIFI_H
+#define NATIVE_WIFI_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+
+class WiFiClass {
+public:
+    bool mode(wifi_mode_t m) { return true; }
+    wl_status_t begin(const char* ssid, const char* password = nullptr) { return status(); }
+    bool disconnect(bool wifioff = false) { return true; }
+    wl_status_t status() { return NativeHW::isWiFiConnected() ? WL_CONNECTED : WL_DISCONNECTED; }
+    IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+    int8_t RSSI() { return -50; }
+    bool softAP(const char* ssid, const char* password = nullptr) { return true; }
+    IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+};
+
+extern WiFiClass WiFi;
+
+#endif // NATIVE_WIFI_H
@@ -0,0 +1,24 @@
+/**
+ * @file WiFiClientSecure.h
+ * @brief TLS client stand-in for the native build (no network I/O)
+ */
+
+#ifndef NATIVE_WIFICLIENTSECURE_H
+#define NATIVE_WIFICLIENTSECURE_H
+
+#include "WiFi.h"
+
+class WiFiClient {
+public:
+    virtual ~WiFiClient() {}
+    void setTimeout(uint32_t timeoutMs) {}
+};
+
+class WiFiClientSecure : public WiFiClient {
+public:
+    void setCACert(const char* rootCA) {}
+    void setInsecure() {}
+    void setHandshakeTimeout(unsigned long seconds) {}
+};
+
+#endif // NATIVE_WIFICLIENTSECURE_H
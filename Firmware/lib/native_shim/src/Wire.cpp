@@ -0,0 +1,8 @@
+/**
+ * @file Wire.cpp
+ * @brief I2C stand-in globals
+ */
+
+#include "Wire.h"
+
+TwoWire Wire;
@@ -0,0 +1,19 @@
+/**
+ * @file Wire.h
+ * @brief I2C stand-in for the native build
+ */
+
+#ifndef NATIVE_WIRE_H
+#define NATIVE_WIRE_H
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { return true; }
+    void setClock(uint32_t frequency) {}
+};
+
+extern TwoWire Wire;
+
+#endif // NATIVE_WIRE_H
@@ -0,0 +1,26 @@
+/**
+ * @file ld2410.h
+ * @brief LD2410 radar stand-in for the native build (driven by NativeHW::setPresence)
+ */
+
+#ifndef NATIVE_LD2410_H
+#define NATIVE_LD2410_H
+
+#include "Arduino.h"
+
+class ld2410 {
+public:
+    uint8_t firmware_major_version = 2;
+    uint8_t firmware_minor_version = 4;
+    uint32_t firmware_bugfix_version = 0;
+
+    bool begin(HardwareSerial& radarStream, bool waitForRadar = true) { return true; }
+    bool read() { return true; }
+    bool presenceDetected() { return NativeHW::getPresence(); }
+    bool stationaryTargetDetected() { return NativeHW::getPresence(); }
+    uint16_t stationaryTargetDistance() { return NativeHW::getPresence() ? NativeHW::getPresenceDistance() : 0; }
+    bool movingTargetDetected() { return false; }
+    uint16_t movingTargetDistance() { return 0; }
+};
+
+#endif // NATIVE_LD2410_H
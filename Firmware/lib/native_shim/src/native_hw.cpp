@@ -0,0 +1,58 @@
+/**
+ * @file native_hw.cpp
+ * @brief Virtual clock and simulated hardware state
+ */
+
+#include <atomic>
+#include "native_hw.h"
+
+namespace {
+    std::atomic<uint64_t> virtualMicros(0);   // Read from the LED output thread too
+    time_t epochAtStart = 1735689600;   // 2025-01-01 00:00:00 UTC
+    uint32_t analogMilliVolts[64] = {0};
+    float temperatureC[NativeHW::MAX_TEMPERATURE_PROBES] = {
+        25.0f, -127.0f, -127.0f, -127.0f, -127.0f, -127.0f, -127.0f, -127.0f};
+    uint32_t busSearches = 0;
+    bool presenceDetected = false;
+    uint16_t presenceDistance = 0;
+    bool serialEcho = true;
+    bool wifiConnected = true;
+    bool brokerReachable = true;
+    uint32_t brokerConnectMs = 0;
+}
+
+namespace NativeHW {
+    void advanceMicros(uint64_t us) { virtualMicros += us; }
+    void advanceMillis(uint32_t ms) { virtualMicros += (uint64_t)ms * 1000; }
+    uint64_t nowMicros() { return virtualMicros; }
+    void setEpoch(time_t epoch) { epochAtStart = epoch; }
+    time_t wallClock() { return epochAtStart + (time_t)(virtualMicros / 1000000); }
+
+    void setSerialEcho(bool enabled) { serialEcho = enabled; }
+    bool isSerialEcho() { return serialEcho; }
+
+    void setAnalogMilliVolts(uint8_t pin, uint32_t mv) { analogMilliVolts[pin & 63] = mv; }
+    uint32_t getAnalogMilliVolts(uint8_t pin) { return analogMilliVolts[pin & 63]; }
+    void setTemperatureC(float celsius) { temperatureC[0] = celsius; }
+    float getTemperatureC() { return temperatureC[0]; }
+    void setTemperatureC(uint8_t probe, float celsius) {
+        if (probe < MAX_TEMPERATURE_PROBES) temperatureC[probe] = celsius;
+    }
+    float getTemperatureC(uint8_t probe) {
+        return probe < MAX_TEMPERATURE_PROBES ? temperatureC[probe] : -127.0f;
+    }
+    void countBusSearch() { busSearches++; }
+    uint32_t getBusSearchCount() { return busSearches; }
+    void setPresence(bool detected, uint16_t distanceCm) {
+        presenceDetected = detected;
+        presenceDistance = distanceCm;
+    }
+    bool getPresence() { return presenceDetected; }
+    uint16_t getPresenceDistance() { return presenceDistance; }
+    void setWiFiConnected(bool connected) { wifiConnected = connected; }
+    bool isWiFiConnected() { return wifiConnected; }
+    void setBrokerReachable(bool reachable) { brokerReachable = reachable; }
+    bool isBrokerReachable() { return brokerReachable; }
+    void setBrokerConnectMs(uint32_t ms) { brokerConnectMs = ms; }
+    uint32_t getBrokerConnectMs() { return brokerConnectMs; }
+}
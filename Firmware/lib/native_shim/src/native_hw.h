@@ -0,0 +1,49 @@
+/**
+ * @file native_hw.h
+ * @brief Virtual clock and simulated hardware for the native (host) build
+ *
+ * The shims read from this state instead of real peripherals, so host runs
+ * are deterministic: time only moves when delay()/advance() is called and
+ * sensor values are whatever the test driver sets.
+ */
+
+#ifndef NATIVE_HW_H
+#define NATIVE_HW_H
+
+#include <stdint.h>
+#include <time.h>
+
+namespace NativeHW {
+    // ==================== Virtual Clock ====================
+    void advanceMicros(uint64_t us);
+    void advanceMillis(uint32_t ms);
+    uint64_t nowMicros();
+    void setEpoch(time_t epoch);    // Wall clock (time()) at virtual t = 0
+    time_t wallClock();             // epoch + virtual seconds
+
+    // ==================== Serial ====================
+    void setSerialEcho(bool enabled);   // Print Serial output to stdout (default on)
+    bool isSerialEcho();
+
+    // ==================== Simulated Peripherals ====================
+    void setAnalogMilliVolts(uint8_t pin, uint32_t mv);
+    uint32_t getAnalogMilliVolts(uint8_t pin);
+    static const uint8_t MAX_TEMPERATURE_PROBES = 8;
+    void setTemperatureC(float celsius);   // DS18B20 reading (-127 = disconnected)
+    float getTemperatureC();
+    void setTemperatureC(uint8_t probe, float celsius);  // Probes 1.. start disconnected
+    float getTemperatureC(uint8_t probe);
+    void countBusSearch();                 // OneWire ROM searches so far
+    uint32_t getBusSearchCount();
+    void setPresence(bool detected, uint16_t distanceCm);
+    bool getPresence();
+    uint16_t getPresenceDistance();
+    void setWiFiConnected(bool connected);
+    bool isWiFiConnected();
+    void setBrokerReachable(bool reachable);
+    bool isBrokerReachable();
+    void setBrokerConnectMs(uint32_t ms);   // Virtual time one connect() takes (TLS + CONNECT)
+    uint32_t getBrokerConnectMs();
+}
+
+#endif // NATIVE_HW_H
@@ -0,0 +1,71 @@
+/**
+ * @file native_main.cpp
+ * @brief Host entry point: runs setup()/loop() under the virtual clock
+ *
+ * Usage: program [--seconds N] [--quiet] [--probes N] [--outage START SECONDS] [--fs DIR]
+ *                [--connect-ms N]
+ * --probes connects N DS18B20 probes (25.0, 25.5, 26.0 ... °C).
+ * --outage makes the broker unreachable from START for SECONDS (virtual time).
+ * --connect-ms makes every broker connect() take N ms (TLS handshake).
+ * --fs keeps LittleFS in DIR across runs; by default every run starts with an
+ * empty one in a new temporary directory.
+ * Host tools with their own main() build with -DNATIVE_NO_MAIN.
+ */
+
+#ifndef NATIVE_NO_MAIN
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Arduino.h"
+#include "DallasTemperature.h"
+#include "LittleFS.h"
+
+int main(int argc, char** argv) {
+    unsigned long simulatedSeconds = 60;
+    unsigned long outageStartMs = 0;
+    unsigned long outageMs = 0;
+    const char* fsRoot = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            simulatedSeconds = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            NativeHW::setSerialEcho(false);
+        } else if (strcmp(argv[i], "--probes") == 0 && i + 1 < argc) {
+            unsigned long probes = strtoul(argv[++i], nullptr, 10);
+            for (uint8_t p = 0; p < NativeHW::MAX_TEMPERATURE_PROBES; p++) {
+                NativeHW::setTemperatureC(p, p < probes ? 25.0f + p * 0.5f : DEVICE_DISCONNECTED_C);
+            }
+        } else if (strcmp(argv[i], "--outage") == 0 && i + 2 < argc) {
+            outageStartMs = strtoul(argv[++i], nullptr, 10) * 1000UL;
+            outageMs = strtoul(argv[++i], nullptr, 10) * 1000UL;
+        } else if (strcmp(argv[i], "--connect-ms") == 0 && i + 1 < argc) {
+            NativeHW::setBrokerConnectMs(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--fs") == 0 && i + 1 < argc) {
+            fsRoot = argv[++i];
+        }
+    }
+
+    static char fsTemplate[] = "/tmp/native_fs_XXXXXX";
+    LittleFSFS::setHostRoot(fsRoot ? fsRoot : mkdtemp(fsTemplate));
+
+    setup();
+
+    unsigned long endMs = millis() + simulatedSeconds * 1000UL;
+    while ((long)(millis() - endMs) < 0) {
+        unsigned long before = micros();
+        if (outageMs > 0) {
+            unsigned long now = millis();
+            NativeHW::setBrokerReachable(now < outageStartMs || now - outageStartMs >= outageMs);
+        }
+        loop();
+        if (micros() == before) {
+            delay(1);  // loop() without a delay() must still move virtual time
+        }
+    }
+
+    return 0;
+}
+
+#endif // NATIVE_NO_MAIN
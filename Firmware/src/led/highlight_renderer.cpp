@@ -0,0 +1,95 @@
+/**
+ * @file highlight_renderer.cpp
+ * @brief Sparse point-light highlight renderer implementation
+ */
+
+#include "highlight_renderer.h"
+
+HighlightRenderer::HighlightRenderer() {
+    for (int i = 0; i < MAX_SOURCES; i++) {
+        sources[i].enabled = false;
+        sources[i].center = 0;
+        sources[i].amplitude = 0;
+        sources[i].color = CRGB(0, 0, 0);
+        buildKernel(sources[i], 0);
+    }
+}
+
+void HighlightRenderer::buildKernel(LightSource& source, uint8_t radius) {
+    if (radius > MAX_KERNEL_RADIUS) {
+        radius = MAX_KERNEL_RADIUS;
+    }
+    source.radius = radius;
+    
+    if (radius < 1) {
+        source.kernel[0] = 255;
+        return;
+    }
+    
+    // Raised cosine (Hann) window normalized to a peak of 255
+    for (int d = -radius; d <= radius; d++) {
+        float w = 0.5f * (1.0f + cos((PI * d) / radius));
+        source.kernel[d + radius] = (uint8_t)(w * 255.0f + 0.5f);
+    }
+}
+
+void HighlightRenderer::setSource(uint8_t id, int center, uint8_t radius, uint8_t amplitude, CRGB color) {
+    if (id >= MAX_SOURCES) {
+        return;
+    }
+    
+    LightSource& source = sources[id];
+    if (source.radius != radius || !source.enabled) {
+        buildKernel(source, radius);
+    }
+    source.enabled = true;
+    source.center = center;
+    source.amplitude = amplitude;
+    source.color = color;
+}
+
+void HighlightRenderer::disableSource(uint8_t id) {
+    if (id < MAX_SOURCES) {
+        sources[id].enabled = false;
+    }
+}
+
+void HighlightRenderer::render(CRGB* leds, int numLeds) {
+    if (numLeds <= 0) {
+        return;
+    }
+    
+    for (int s = 0; s < MAX_SOURCES; s++) {
+        const LightSource& source = sources[s];
+        if (!source.enabled || source.amplitude == 0) {
+            continue;
+        }
+        
+        int span = 2 * source.radius + 1;
+        if (span > numLeds) {
+            span = numLeds;  // Short strip: never touch an LED twice
+        }
+        
+        // First LED covered by the kernel, wrapped into [0, numLeds)
+        int idx = (source.center - source.radius) % numLeds;
+        if (idx < 0) {
+            idx += numLeds;
+        }
+        
+        for (int k = 0; k < span; k++) {
+            // Blend weight = kernel * amplitude, both Q0.8
+            uint16_t w = (source.kernel[k] * source.amplitude + 255) >> 8;
+            w += w >> 7;  // Map 255 -> 256 so a full weight reaches the source colour
+            uint16_t inv = 256 - w;
+            
+            CRGB& px = leds[idx];
+            px.r = (px.r * inv + source.color.r * w) >> 8;
+            px.g = (px.g * inv + source.color.g * w) >> 8;
+            px.b = (px.b * inv + source.color.b * w) >> 8;
+            
+            if (++idx == numLeds) {
+                idx = 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ * @file led_compositor.cpp
+ * @brief Overlay layer compositor implementation
+ */
+
+#include "led_compositor.h"
+
+#define FLATTEN_RUN_BYTES 192   // 64 LEDs
+
+static const char* const BLEND_MODE_NAMES[BLEND_MODE_COUNT] = {
+    "normal", "add", "screen", "multiply", "lighten"
+};
+
+const char* getBlendModeName(LEDBlendMode mode) {
+    if (mode < 0 || mode >= BLEND_MODE_COUNT) {
+        return BLEND_MODE_NAMES[BLEND_NORMAL];
+    }
+    return BLEND_MODE_NAMES[mode];
+}
+
+bool findBlendModeByName(const char* name, LEDBlendMode& mode) {
+    if (name == nullptr) {
+        return false;
+    }
+    for (int i = 0; i < BLEND_MODE_COUNT; i++) {
+        if (strcmp(BLEND_MODE_NAMES[i], name) == 0) {
+            mode = (LEDBlendMode)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// x * y / 255 with 255 * 255 -> 255 and 0 * y -> 0, no division
+static inline uint8_t mul8(uint8_t x, uint8_t y) {
+    return ((uint16_t)x * (y + 1)) >> 8;
+}
+
+// One channel of one layer. weight = opacity + 1 (1..256). Every mode
+// computes its full-strength result, then moves the base towards it by the
+// opacity; the result never leaves 0..255.
+template <LEDBlendMode BLEND>
+static inline uint8_t blendChannel(uint8_t base, uint8_t top, uint16_t weight) {
+    uint8_t target;
+    switch (BLEND) {
+        case BLEND_ADD: {
+            uint16_t sum = base + ((top * weight) >> 8);
+            return sum > 255 ? 255 : sum;
+        }
+        case BLEND_SCREEN:
+            target = 255 - mul8(255 - base, 255 - top);
+            return base + (((target - base) * weight) >> 8);
+        case BLEND_MULTIPLY:
+            target = mul8(base, top);
+            return base - (((base - target) * weight) >> 8);
+        case BLEND_LIGHTEN:
+            target = top > base ? top : base;
+            return base + (((target - base) * weight) >> 8);
+        case BLEND_NORMAL:
+        default:
+            return (base * (256 - weight) + top * weight) >> 8;
+    }
+}
+
+// Branch-free inner loop per blend mode
+template <LEDBlendMode BLEND>
+static void blendRun(uint8_t* out, const uint8_t* top, int count, uint16_t weight) {
+    for (int i = 0; i < count; i++) {
+        out[i] = blendChannel<BLEND>(out[i], top[i], weight);
+    }
+}
+
+static void blendRun(LEDBlendMode blend, uint8_t* out, const uint8_t* top, int count, uint16_t weight) {
+    switch (blend) {
+        case BLEND_ADD:      blendRun<BLEND_ADD>(out, top, count, weight); break;
+        case BLEND_SCREEN:   blendRun<BLEND_SCREEN>(out, top, count, weight); break;
+        case BLEND_MULTIPLY: blendRun<BLEND_MULTIPLY>(out, top, count, weight); break;
+        case BLEND_LIGHTEN:  blendRun<BLEND_LIGHTEN>(out, top, count, weight); break;
+        default:             blendRun<BLEND_NORMAL>(out, top, count, weight); break;
+    }
+}
+
+LEDCompositor::LEDCompositor() {
+    numLeds = 0;
+    for (int i = 0; i < MAX_LAYERS; i++) {
+        layers[i].pixels = nullptr;
+        layers[i].blend = BLEND_NORMAL;
+        layers[i].opacity = 255;
+        layers[i].enabled = false;
+    }
+}
+
+bool LEDCompositor::begin(int leds, LEDBufferPool& pool) {
+    for (int i = 0; i < MAX_LAYERS; i++) {
+        layers[i].pixels = pool.take(leds);
+        if (layers[i].pixels == nullptr) {
+            return false;
+        }
+    }
+    numLeds = leds;
+    return true;
+}
+
+void LEDCompositor::setLayer(int index, LEDBlendMode blend, uint8_t opacity) {
+    if (index < 0 || index >= MAX_LAYERS || layers[index].pixels == nullptr) {
+        return;
+    }
+    if (!layers[index].enabled) {
+        // Start from a transparent (black) layer
+        for (int i = 0; i < numLeds; i++) layers[index].pixels[i] = CRGB(0, 0, 0);
+    }
+    layers[index].blend = blend;
+    layers[index].opacity = opacity;
+    layers[index].enabled = true;
+}
+
+void LEDCompositor::disableLayer(int index) {
+    if (index >= 0 && index < MAX_LAYERS) {
+        layers[index].enabled = false;
+    }
+}
+
+bool LEDCompositor::isLayerEnabled(int index) {
+    return index >= 0 && index < MAX_LAYERS && layers[index].enabled;
+}
+
+CRGB* LEDCompositor::pixels(int index) {
+    if (index < 0 || index >= MAX_LAYERS) {
+        return nullptr;
+    }
+    return layers[index].pixels;
+}
+
+void LEDCompositor::flatten(CRGB* frame) {
+    // Gather the enabled layers so the inner loop touches nothing else
+    const uint8_t* sources[MAX_LAYERS];
+    LEDBlendMode blends[MAX_LAYERS];
+    uint16_t weights[MAX_LAYERS];
+    int count = 0;
+    for (int i = 0; i < MAX_LAYERS; i++) {
+        if (layers[i].enabled && layers[i].opacity > 0) {
+            sources[count] = (const uint8_t*)layers[i].pixels;
+            blends[count] = layers[i].blend;
+            weights[count] = layers[i].opacity + 1;
+            count++;
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+    
+    // Every mode is per channel, so walk the raw bytes once in short runs:
+    // each run stays in L1 while all layers are applied to it, and each
+    // layer's loop has no per-byte branching
+    uint8_t* out = (uint8_t*)frame;
+    int bytes = numLeds * 3;
+    for (int start = 0; start < bytes; start += FLATTEN_RUN_BYTES) {
+        int run = bytes - start < FLATTEN_RUN_BYTES ? bytes - start : FLATTEN_RUN_BYTES;
+        for (int l = 0; l < count; l++) {
+            blendRun(blends[l], out + start, sources[l] + start, run, weights[l]);
+        }
+    }
+}
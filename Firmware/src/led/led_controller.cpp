@@ -1,6 +1,6 @@
 /**
  * @file led_controller.cpp
- * @brief LED effects implementation
+ * @brief LED controller implementation
  */
 
 #include <Arduino.h>
@@ -8,29 +8,74 @@
 #include <ld2410.h>
 #include "led_controller.h"
 #include "config.h"
-#include <time.h>
-
-
-// Physical constants for black body radiation
-const float h = 6.626e-34;  // Planck's constant (J·s)
-const float c = 3.0e8;      // Speed of light (m/s)
-const float k = 1.381e-23;  // Boltzmann constant (J/K)
 
 LEDController::LEDController() {
     currentMode = MODE_OFF;
     brightness = DEFAULT_BRIGHTNESS;
-    effectState = 0;
+    defaultLEDLayout(layout);
+}
+
+void LEDController::setSink(LEDSink* outputSink) {
+    if (outputSink != nullptr) {
+        sink = outputSink;
+    }
+}
+
+void LEDController::setLayout(const LEDLayout& newLayout) {
+    if (numLeds > 0) {
+        Serial.println("[LED] ERROR: Layout can only be set before init()");
+        return;
+    }
+    if (!validateLEDLayout(newLayout)) {
+        Serial.println("[LED] ERROR: Invalid layout, keeping the default");
+        return;
+    }
+    layout = newLayout;
+}
+
+const LEDLayout& LEDController::getLayout() {
+    return layout;
 }
 
 bool LEDController::init() {
-    FastLED.addLeds<LED_TYPE, LED_PIN, COLOR_ORDER>(leds, NUM_LEDS);
-    FastLED.setBrightness(brightness);
-    FastLED.clear();
-    FastLED.show();
+    // Every per-LED buffer comes from this one allocation
+    size_t poolLeds = (size_t)layout.numLeds *
+                      (FRAME_BUFFERS + LEDCompositor::FRAME_BUFFERS + RenderPipeline::FRAME_BUFFERS +
+                       LEDSink::MAX_FRAME_BUFFERS);
+    if (!pool.allocate(poolLeds)) {
+        Serial.println("[LED] ERROR: Not enough memory for " + String(layout.numLeds) + " LEDs");
+        return false;
+    }
+    effectBuffers[0] = pool.take(layout.numLeds);
+    effectBuffers[1] = pool.take(layout.numLeds);
+    frameBuffer = pool.take(layout.numLeds);
+    if (!compositor.begin(layout.numLeds, pool)) {
+        Serial.println("[LED] ERROR: Layer buffers unavailable");
+        return false;
+    }
     
-    initConvolution();
+    if (!pipeline.begin(sink, layout.numLeds, pool)) {
+        Serial.println("[LED] ERROR: Output sink initialization failed");
+        return false;
+    }
+    numLeds = layout.numLeds;
+    if (!pipeline.startTask(LED_OUTPUT_CORE, LED_OUTPUT_INTERVAL_MS)) {
+        return false;
+    }
     
-    Serial.println("[LED] Controller initialized");
+    for (int s = 0; s < layout.segmentCount; s++) {
+        activateSegment(s, segmentMode(s), false);
+    }
+    updateFrameInterval();
+    off();
+    
+    Serial.print("[LED] Controller initialized: ");
+    Serial.print(numLeds);
+    Serial.print(" LEDs, ");
+    Serial.print(layout.segmentCount);
+    Serial.print(" segment(s), pool ");
+    Serial.print(pool.getCapacity() * sizeof(CRGB));
+    Serial.println(" bytes");
     
     return true;
 }
@@ -61,344 +106,333 @@ bool LEDController::checkPresence() {
     return radar->presenceDetected();
 }
 
-void LEDController::setMode(LEDMode mode) {
-    currentMode = mode;
+LEDMode LEDController::segmentMode(int segment) {
+    uint8_t mode = layout.segments[segment].mode;
+    return mode == SEGMENT_FOLLOW_MODE ? currentMode : (LEDMode)mode;
+}
+
+void LEDController::activateSegment(int segment, LEDMode mode, bool fade) {
+    SegmentState& state = segmentStates[segment];
+    const LEDSegment& seg = layout.segments[segment];
+    
+    if (fade) {
+        // Current effect becomes the outgoing one (an unfinished crossfade is
+        // cut short) and the new effect starts from black in the other slot
+        uint8_t incoming = state.active ^ 1;
+        state.slots[incoming].activate(getEffectInfo(mode), nextEffectSeed());
+        if (effectBuffers[incoming] != nullptr) {
+            CRGB* leds = effectBuffers[incoming] + seg.start;
+            for(int i = 0; i < seg.length; i++) leds[i] = CRGB(0, 0, 0);
+        }
+        state.active = incoming;
+        state.fading = true;
+    } else {
+        state.slots[state.active ^ 1].release();
+        state.slots[state.active].activate(getEffectInfo(mode), nextEffectSeed());
+        state.fading = false;
+    }
+}
+
+void LEDController::setMode(LEDMode mode, uint16_t fadeMs) {
+    const EffectInfo& info = getEffectInfo(mode);
+    currentMode = info.mode;
     
-    if (mode == MODE_OFF) {
+    // Segments with a fixed effect keep running untouched (composeFrame()
+    // still blacks them out while the mode is off)
+    bool fade = fadeMs > 0;
+    transitionActive = false;
+    for (int s = 0; s < layout.segmentCount; s++) {
+        if (layout.segments[s].mode == SEGMENT_FOLLOW_MODE) {
+            activateSegment(s, currentMode, fade);
+            transitionActive |= fade;
+        } else if (!fade) {
+            segmentStates[s].fading = false;
+        }
+    }
+    if (transitionActive) {
+        transitionMs = fadeMs > MAX_TRANSITION_MS ? MAX_TRANSITION_MS : fadeMs;
+        transitionElapsedMs = 0;
+    } else if (currentMode == MODE_OFF && numLeds > 0) {
         off();
     }
+    updateFrameInterval();
+    restartFrameClock();
     
     Serial.print("[LED] Mode changed to: ");
-    Serial.println(mode);
+    Serial.print(info.name);
+    if (fadeMs > 0) {
+        Serial.print(" (fade ");
+        Serial.print(fadeMs > MAX_TRANSITION_MS ? MAX_TRANSITION_MS : fadeMs);
+        Serial.print(" ms)");
+    }
+    Serial.println();
 }
 
 LEDMode LEDController::getMode() {
     return currentMode;
-    }
+}
+
+bool LEDController::isTransitioning() {
+    return transitionActive;
+}
 
-    void LEDController::setBrightness(uint8_t newBrightness) {
+void LEDController::setBrightness(uint8_t newBrightness) {
     brightness = newBrightness;
-    FastLED.setBrightness(brightness);
+    forceShow = true;  // Brightness travels with the next submitted frame
     
     Serial.print("[LED] Brightness set to: ");
     Serial.println(brightness);
 }
 
-void LEDController::update() {
-    // Execute current mode
-    switch(currentMode) {
-        case MODE_OFF:
-        // LEDs stay off
-        break;
-        case MODE_SKY_SIMULATION:
-        skySimulationEffect();
-        break;
-        case MODE_RAIN:
-        rainEffect();
-        break;
-        case MODE_METEOR:
-        meteorEffect();
-        break;
-        case MODE_APOCALYPSE:
-        apocalypseEffect();
-        break;
-        case MODE_BASIC:
-        // Ensure LEDs reflect current custom color
-        for(int i = 0; i < NUM_LEDS; i++) leds[i] = customColor;
-        break;
-    }
-    
-    FastLED.show();
+void LEDController::setEffectSeed(uint32_t seed) {
+    effectSeed = seed;
 }
 
-void LEDController::off() {
-    FastLED.clear();
-    FastLED.show();
-}
-
-void LEDController::setCustomColor(uint8_t r, uint8_t g, uint8_t b) {
-    customColor = CRGB(r,g,b);
-    for(int i = 0; i < NUM_LEDS; i++) leds[i] = customColor;
-    currentMode = MODE_BASIC;
+uint32_t LEDController::nextEffectSeed() {
+    effectSeed += 0x9E3779B9UL;  // Golden-ratio step, EffectRandom::seed() scrambles it further
+    return effectSeed;
 }
 
-// ==================== Sky Simulation Effect ====================
-void LEDController::initConvolution() {
-    // Initialize cosine kernel for smooth transitions
-    for(int i = 0; i < NUM_LEDS; i++) {
-        sunSignal[i] = 0;
-        convolvedSignal[i] = 0;
-    }
-    buildSunKernel(sunKernelRadius);
-}
-
-void LEDController::buildSunKernel(int radius) {
-    // Raised cosine (Hann) window centered, normalized to peak 1.0
-    // Kernel stored in sunKernel with length NUM_LEDS (unused entries set 0)
-    for(int i = 0; i < NUM_LEDS; i++) sunKernel[i] = 0.0f;
-    if(radius < 1) { sunKernel[0] = 1.0f; return; }
-    for(int d = -radius; d <= radius; d++) {
-        float w = 0.5f * (1.0f + cos((PI * d) / radius)); // Hann shape
-        sunKernel[d + radius] = w; // temporary contiguous storage if needed
-    }
-    // Normalize peak and overall energy (optional)
-    float maxVal = 0.0f;
-    for(int d = -radius; d <= radius; d++) {
-        float val = sunKernel[d + radius];
-        if(val > maxVal) maxVal = val;
-    }
-    if(maxVal > 0) {
-        for(int d = -radius; d <= radius; d++) sunKernel[d + radius] /= maxVal;
+void LEDController::updateFrameInterval() {
+    // Run at the pace of the fastest effect on the strip
+    frameIntervalMs = 0xFFFF;
+    for (int s = 0; s < layout.segmentCount; s++) {
+        uint16_t interval = getEffectInfo(segmentMode(s)).frameIntervalMs;
+        if (interval < frameIntervalMs) {
+            frameIntervalMs = interval;
+        }
     }
-}
-
-int LEDController::getSunPositionIndex(float hourFloat) {
-    // Map daylight hours (6 -> 18) to full rotation around cylinder
-    // At night we still return a position but intensity will be 0
-    float wrappedHour = fmod(hourFloat + 24.0f, 24.0f);
-    float daylightSpanStart = 6.0f;
-    float daylightSpanEnd = 18.0f; // inclusive-ish
-    float span = daylightSpanEnd - daylightSpanStart;
-    float t = (wrappedHour - daylightSpanStart) / span; // 0..1 during day
-    if(t < 0) t += 1.0f; // before 6 -> treat as night
-    // Use continuous rotation irrespective of day/night so sun keeps moving
-    float rotationFraction = fmod(wrappedHour / 24.0f, 1.0f); // 0..1 over 24h
-    int idx = (int)(rotationFraction * NUM_LEDS) % NUM_LEDS;
-    return idx;
-}
-
-float LEDController::getSunIntensity(float hourFloat) {
-    // Simple elevation curve: zero at night, cosine arch during daylight
-    if(hourFloat < 6.0f || hourFloat > 18.0f) return 0.0f;
-    float t = (hourFloat - 6.0f) / 12.0f; // 0 at 6h, 1 at 18h
-    // Elevation approximated with sine: peak at midday (t=0.5)
-    float elev = sin(PI * t); // 0..1
-    if(elev < 0) elev = 0;
-    return elev;
-}
-
-void LEDController::applySunConvolution(int centerIndex, float amplitude) {
-    // Clear previous signals
-    for(int i = 0; i < NUM_LEDS; i++) {
-        sunSignal[i] = 0.0f;
-        convolvedSignal[i] = 0.0f;
-    }
-    sunSignal[centerIndex] = amplitude; // delta pulse
-    int R = sunKernelRadius;
-    // Convolution with circular wrap
-    for(int led = 0; led < NUM_LEDS; led++) {
-        float acc = 0.0f;
-        for(int d = -R; d <= R; d++) {
-        int src = (led - d + NUM_LEDS) % NUM_LEDS;
-        float k = sunKernel[d + R];
-        acc += sunSignal[src] * k;
+    for (int l = 0; l < LED_MAX_LAYERS; l++) {
+        const EffectInfo* info = layerSlots[l].getInfo();
+        if (info != nullptr && info->frameIntervalMs < frameIntervalMs) {
+            frameIntervalMs = info->frameIntervalMs;
         }
-        convolvedSignal[led] = acc; // 0..amplitude
     }
 }
 
-float LEDController::planckRadiance(float lambda_nm, float T) {
-    float lambda = lambda_nm * 1e-9;
-    float exp_term = (h * c) / (lambda * k * T);
-    
-    if (exp_term > 50) return 0;
-    
-    float denominator = exp(exp_term) - 1.0;
-    if (denominator < 1e-10) return 0;
+bool LEDController::setLayer(uint8_t layer, LEDMode mode, LEDBlendMode blend, uint8_t opacity) {
+    if (layer >= LED_MAX_LAYERS || numLeds == 0) {
+        return false;
+    }
+    const EffectInfo& info = getEffectInfo(mode);
+    // Keep a running effect when only blend/opacity change
+    if (layerSlots[layer].getInfo() != &info || !compositor.isLayerEnabled(layer)) {
+        layerSlots[layer].activate(info, nextEffectSeed());
+    }
+    compositor.setLayer(layer, blend, opacity);
+    updateFrameInterval();
+    nextFrameMs = millis();
     
-    return 1.0 / (pow(lambda, 5) * denominator);
+    Serial.print("[LED] Layer ");
+    Serial.print(layer);
+    Serial.print(": ");
+    Serial.print(info.name);
+    Serial.print(" ");
+    Serial.print(getBlendModeName(blend));
+    Serial.print(" ");
+    Serial.println(opacity);
+    return true;
 }
 
-LEDController::SkyColor LEDController::colorTempToRGB(float temp) {
-    float lambda_r = 700;
-    float lambda_g = 546;
-    float lambda_b = 436;
-    
-    float I_r = planckRadiance(lambda_r, temp);
-    float I_g = planckRadiance(lambda_g, temp);
-    float I_b = planckRadiance(lambda_b, temp);
-    
-    float maxI = max(max(I_r, I_g), I_b);
-    
-    float r_norm = I_r / maxI;
-    float g_norm = I_g / maxI;
-    float b_norm = I_b / maxI;
-    
-    r_norm = pow(r_norm, 1.0/2.2);
-    g_norm = pow(g_norm, 1.0/2.2);
-    b_norm = pow(b_norm, 1.0/2.2);
-    
-    SkyColor color;
-    color.r = (uint8_t)(r_norm * 255);
-    color.g = (uint8_t)(g_norm * 255);
-    color.b = (uint8_t)(b_norm * 255);
+void LEDController::clearLayer(uint8_t layer) {
+    if (layer >= LED_MAX_LAYERS) {
+        return;
+    }
+    compositor.disableLayer(layer);
+    layerSlots[layer].release();
+    updateFrameInterval();
+    nextFrameMs = millis();
     
-    return color;
+    Serial.print("[LED] Layer ");
+    Serial.print(layer);
+    Serial.println(" cleared");
 }
 
-float LEDController::getSunColorTemp(float hourFloat) {
-    if (hourFloat < 6.0 || hourFloat > 18.5) {
-        return 0;
-    }
-    else if (hourFloat < 7.0) {
-        float t = (hourFloat - 6.0);
-        return 2000 + 2000 * t;
-    }
-    else if (hourFloat < 8.0) {
-        float t = (hourFloat - 7.0);
-        return 4000 + 1500 * t;
-    }
-    else if (hourFloat < 12.0) {
-        return 5500;
-    }
-    else if (hourFloat < 17.0) {
-        return 5500;
-    }
-    else if (hourFloat < 18.0) {
-        float t = (hourFloat - 17.0);
-        return 5500 - 1500 * t;
-    }
-    else {
-        float t = (hourFloat - 18.0);
-        return 4000 - 2000 * t;
-    }
+void LEDController::restartFrameClock() {
+    // Render the first frame of a new mode immediately
+    unsigned long now = millis();
+    nextFrameMs = now;
+    lastFrameMs = now - frameIntervalMs;
 }
 
-void LEDController::skySimulationEffect() {
-    time_t now = time(nullptr);
-    struct tm* timeinfo = localtime(&now);
-    
-    float hourFloat = timeinfo->tm_hour + timeinfo->tm_min / 60.0;
-    float sunTemp = getSunColorTemp(hourFloat);
-    int sunIndex = getSunPositionIndex(hourFloat);
-    float sunIntensity = getSunIntensity(hourFloat); // 0..1
-    applySunConvolution(sunIndex, sunIntensity);
-    
-    // Base ambient color (dimmer at night)
-    CRGB ambient;
-    if (sunTemp > 0) {
-        SkyColor skyColor = colorTempToRGB(sunTemp);
-        ambient = CRGB(skyColor.r, skyColor.g, skyColor.b);
-    } else {
-        ambient = CRGB(0, 0, 10);
-    }
+LEDFrameStats LEDController::getFrameStats() {
+    return frameStats;
+}
 
-    // Highlight color (warmer at low sunTemp, neutral midday)
-    SkyColor sunColor = colorTempToRGB(max(sunTemp, 2000.0f));
+LEDPipelineStats LEDController::getPipelineStats() {
+    return pipeline.getStats();
+}
 
-    for(int i = 0; i < NUM_LEDS; i++) {
-        float highlight = convolvedSignal[i]; // 0..1
-        // Mix ambient with sun highlight (linear blend)
-        float mixR = ambient.r + highlight * (sunColor.r - ambient.r);
-        float mixG = ambient.g + highlight * (sunColor.g - ambient.g);
-        float mixB = ambient.b + highlight * (sunColor.b - ambient.b);
-        // Gentle gamma correction (approx)
-        leds[i] = CRGB((uint8_t)mixR, (uint8_t)mixG, (uint8_t)mixB);
+void LEDController::update() {
+    if (numLeds == 0) {
+        return;
     }
-
-    static unsigned long lastLog = 0;
-    unsigned long nowMs = millis();
-    if(nowMs - lastLog > 5000) { // log every 5s
-        Serial.print("[LED] Sun idx:"); Serial.print(sunIndex);
-        Serial.print(" intensity:"); Serial.print(sunIntensity, 3);
-        Serial.print(" temp:"); Serial.println(sunTemp);
-        lastLog = nowMs;
+    unsigned long now = millis();
+    
+    // Not due yet - return immediately so the main loop keeps running
+    if ((long)(now - nextFrameMs) < 0) {
+        return;
     }
-}
-
-// ==================== Rain Effect ====================
-void LEDController::rainEffect() {
-    static unsigned long lastLightning = 0;
-    static bool lightningActive = false;
-    static int lightningBrightness = 0;
-    static int lightningPosition = 0;
     
-    // Base stormy sky
-    for(int i = 0; i < NUM_LEDS; i++) {
-        leds[i] = CRGB(5, 8, 15);
-        leds[i].r += random(-2, 3);
-        leds[i].g += random(-2, 3);
-        leds[i].b += random(-3, 5);
+    uint16_t interval = frameIntervalMs;
+    unsigned long behind = now - nextFrameMs;
+    uint32_t missed = behind / interval;
+    if (missed > 0) {
+        frameStats.dropped += missed;
+    }
+    if (behind > interval / 4) {
+        frameStats.late++;
     }
+    // Stay on the frame grid instead of drifting by the lateness
+    nextFrameMs += (unsigned long)interval * (missed + 1);
+    
+    uint32_t dtMs = now - lastFrameMs;
+    lastFrameMs = now;
     
-    // Random raindrops
-    if(random(100) < 30) {
-        int pos = random(NUM_LEDS);
-        leds[pos] = CRGB(2, 5, 10);
+    if (transitionActive) {
+        transitionElapsedMs += dtMs;
+        if (transitionElapsedMs >= transitionMs) {
+            // Done - drop the outgoing effects and output the incoming ones directly
+            transitionActive = false;
+            for (int s = 0; s < layout.segmentCount; s++) {
+                SegmentState& state = segmentStates[s];
+                if (state.fading) {
+                    state.slots[state.active ^ 1].release();
+                    state.fading = false;
+                }
+            }
+        }
     }
     
-    // Lightning
-    unsigned long now = millis();
-    if(!lightningActive && (now - lastLightning > random(3000, 8000))) {
-        lightningActive = true;
-        lightningBrightness = 255;
-        lightningPosition = random(NUM_LEDS / 3, NUM_LEDS * 2 / 3);
-        lastLightning = now;
+    // Render every segment's effect into its range of the framebuffer(s)
+    EffectContext ctx;
+    ctx.dtMs = dtMs;
+    ctx.customColor = customColor;
+    ctx.wallClock = time(nullptr);
+    for (int s = 0; s < layout.segmentCount; s++) {
+        SegmentState& state = segmentStates[s];
+        const LEDSegment& seg = layout.segments[s];
+        ctx.numLeds = seg.length;
+        ctx.leds = effectBuffers[state.active] + seg.start;
+        state.slots[state.active].render(ctx);
+        if (state.fading) {
+            // Keep the outgoing effect animating in its own buffer
+            ctx.leds = effectBuffers[state.active ^ 1] + seg.start;
+            state.slots[state.active ^ 1].render(ctx);
+        }
     }
+    composeFrame();
     
-    if(lightningActive) {
-        int spread = 15;
-        for(int i = max(0, lightningPosition - spread);
-            i < min(NUM_LEDS, lightningPosition + spread); i++) {
-        int distance = abs(i - lightningPosition);
-        int brightness = lightningBrightness * (spread - distance) / spread;
-        leds[i] += CRGB(brightness, brightness, brightness + 20);
+    // Overlays go on top of the mode, and go dark with it
+    if (currentMode != MODE_OFF) {
+        ctx.numLeds = numLeds;
+        for (int l = 0; l < LED_MAX_LAYERS; l++) {
+            if (compositor.isLayerEnabled(l)) {
+                ctx.leds = compositor.pixels(l);
+                layerSlots[l].render(ctx);
+            }
         }
-        
-        lightningBrightness -= 30;
-        if(lightningBrightness <= 0) {
-        lightningActive = false;
+        unsigned long flattenStart = micros();
+        compositor.flatten(frameBuffer);
+        uint32_t flattenUs = micros() - flattenStart;
+        if (flattenUs > frameStats.flattenMaxUs) {
+            frameStats.flattenMaxUs = flattenUs;
         }
     }
+    
+    frameStats.rendered++;
+    showIfChanged();
 }
 
-// ==================== Meteor Effect ====================
-void LEDController::meteorEffect() {
-    static int meteorPos[3] = {0, 20, 40};
-    static int meteorSpeed[3] = {2, 3, 2};
+void LEDController::composeFrame() {
+    // Blend outgoing -> incoming with an 8-bit fixed-point alpha
+    uint16_t alpha = transitionActive ? (transitionElapsedMs << 8) / transitionMs : 256;  // 0..256
+    uint16_t inv = 256 - alpha;
     
-    // Fade all LEDs
-    for(int i = 0; i < NUM_LEDS; i++) {
-        leds[i].fadeToBlackBy(64);
-    }
-    
-    // Draw meteors
-    for(int m = 0; m < 3; m++) {
-        if(meteorPos[m] < NUM_LEDS) {
-        leds[meteorPos[m]] = CRGB(255, 200, 100);
-        
-        // Trail
-        for(int j = 1; j < 8; j++) {
-            if(meteorPos[m] - j >= 0) {
-            leds[meteorPos[m] - j] = CRGB(255/(j+1), 200/(j+1), 100/(j+1));
-            }
+    for (int s = 0; s < layout.segmentCount; s++) {
+        const SegmentState& state = segmentStates[s];
+        const LEDSegment& seg = layout.segments[s];
+        const CRGB* to = effectBuffers[state.active] + seg.start;
+        const CRGB* from = effectBuffers[state.active ^ 1] + seg.start;
+        CRGB* out = frameBuffer + seg.start;
+        int step = 1;
+        if (seg.reversed) {
+            out += seg.length - 1;
+            step = -1;
         }
         
-        meteorPos[m] += meteorSpeed[m];
+        // Off means the whole strip: a fixed-effect segment goes dark too,
+        // fading out alongside the follow segments
+        if (currentMode == MODE_OFF && seg.mode != SEGMENT_FOLLOW_MODE) {
+            if (inv == 0) {
+                for(int i = 0; i < seg.length; i++, out += step) *out = CRGB(0, 0, 0);
+            } else {
+                for(int i = 0; i < seg.length; i++, out += step) {
+                    out->r = (to[i].r * inv) >> 8;
+                    out->g = (to[i].g * inv) >> 8;
+                    out->b = (to[i].b * inv) >> 8;
+                }
+            }
+        } else if (state.fading) {
+            for(int i = 0; i < seg.length; i++, out += step) {
+                out->r = (from[i].r * inv + to[i].r * alpha) >> 8;
+                out->g = (from[i].g * inv + to[i].g * alpha) >> 8;
+                out->b = (from[i].b * inv + to[i].b * alpha) >> 8;
+            }
+        } else if (step == 1) {
+            memcpy(out, to, seg.length * sizeof(CRGB));
         } else {
-        meteorPos[m] = random(-20, 0);
-        meteorSpeed[m] = random(2, 4);
+            for(int i = 0; i < seg.length; i++, out += step) *out = to[i];
         }
     }
-    
-    delay(50);
 }
 
-// ==================== Apocalypse Effect ====================
-void LEDController::apocalypseEffect() {
-    for(int i = 0; i < NUM_LEDS; i++) {
-        int flicker = random(50, 255);
-        leds[i] = CRGB(flicker, flicker/4, 0);
+uint32_t LEDController::hashFrame() {
+    // FNV-1a over the raw bytes of the composed frame
+    const uint8_t* bytes = (const uint8_t*)frameBuffer;
+    uint32_t hash = 2166136261UL;
+    for(size_t i = 0; i < numLeds * sizeof(CRGB); i++) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
     }
-    
-    // Smoke effect (darker patches)
-    if(random(100) < 20) {
-        int pos = random(NUM_LEDS);
-        int width = random(3, 8);
-        for(int i = pos; i < min(pos + width, NUM_LEDS); i++) {
-        leds[i].fadeToBlackBy(150);
-        }
+    return hash;
+}
+
+void LEDController::showIfChanged() {
+    // WS2812 output costs ~30us per LED with interrupts disabled,
+    // so only push frames that actually differ from the last one shown
+    uint32_t hash = hashFrame();
+    if (!forceShow && hash == lastFrameHash) {
+        frameStats.skipped++;
+        return;
     }
     
-    delay(30);
+    pipeline.submit(frameBuffer, brightness);
+    lastFrameHash = hash;
+    forceShow = false;
+    frameStats.shown++;
+}
+
+void LEDController::off() {
+    if (numLeds == 0) {
+        return;
+    }
+    for (int s = 0; s < layout.segmentCount; s++) {
+        const LEDSegment& seg = layout.segments[s];
+        CRGB* leds = effectBuffers[segmentStates[s].active] + seg.start;
+        for(int i = 0; i < seg.length; i++) leds[i] = CRGB(0, 0, 0);
+    }
+    for(int i = 0; i < numLeds; i++) frameBuffer[i] = CRGB(0, 0, 0);
+    pipeline.submit(frameBuffer, brightness);
+    lastFrameHash = hashFrame();
+    forceShow = false;
+}
+
+void LEDController::setCustomColor(uint8_t r, uint8_t g, uint8_t b) {
+    customColor = CRGB(r,g,b);
+    // BasicEffect picks the colour up on the next frame - render it right away
+    if (currentMode != MODE_BASIC) {
+        setMode(MODE_BASIC);
+    } else {
+        nextFrameMs = millis();
+    }
 }
@@ -0,0 +1,297 @@
+/**
+ * @file led_effects.cpp
+ * @brief LED effect implementations and effect registry
+ */
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <new>
+#include "led_effects.h"
+#include "highlight_renderer.h"
+#include "color_temp.h"
+#include "particle_system.h"
+
+// ==================== Off ====================
+class OffEffect : public LEDEffect {
+public:
+    void render(EffectContext& ctx) override {
+        for(int i = 0; i < ctx.numLeds; i++) ctx.leds[i] = CRGB(0, 0, 0);
+    }
+};
+
+// ==================== Basic (solid colour) ====================
+class BasicEffect : public LEDEffect {
+public:
+    void render(EffectContext& ctx) override {
+        for(int i = 0; i < ctx.numLeds; i++) ctx.leds[i] = ctx.customColor;
+    }
+};
+
+// ==================== Sky Simulation Effect ====================
+class SkySimulationEffect : public LEDEffect {
+public:
+    void init() override {
+        sinceLogMs = LOG_INTERVAL_MS;  // Log the first frame
+    }
+
+    void render(EffectContext& ctx) override {
+        struct tm* timeinfo = localtime(&ctx.wallClock);
+
+        float hourFloat = timeinfo->tm_hour + timeinfo->tm_min / 60.0;
+        float sunTemp = getSunColorTemp(hourFloat);
+        int sunIndex = getSunPositionIndex(hourFloat, ctx.numLeds);
+        float sunIntensity = getSunIntensity(hourFloat); // 0..1
+        float moonIntensity = getMoonIntensity(hourFloat); // 0..0.25
+
+        // Base ambient color (dimmer at night)
+        CRGB ambient;
+        if (sunTemp > 0) {
+            ColorTempRGB skyColor = colorTempLookup(sunTemp);
+            ambient = CRGB(skyColor.r, skyColor.g, skyColor.b);
+        } else {
+            ambient = CRGB(0, 0, 59);
+        }
+        for(int i = 0; i < ctx.numLeds; i++) ctx.leds[i] = ambient;
+
+        // Highlight color (warmer at low sunTemp, neutral midday)
+        ColorTempRGB sunColor = colorTempLookup(max(sunTemp, 2000.0f));
+        highlights.setSource(SUN_SOURCE, sunIndex, SUN_KERNEL_RADIUS, (uint8_t)(sunIntensity * 255),
+                             CRGB(sunColor.r, sunColor.g, sunColor.b));
+        // Moon sits opposite the sun on the cylinder
+        highlights.setSource(MOON_SOURCE, sunIndex + ctx.numLeds / 2, MOON_KERNEL_RADIUS,
+                             (uint8_t)(moonIntensity * 255), CRGB(180, 190, 255));
+        highlights.render(ctx.leds, ctx.numLeds);
+
+        sinceLogMs += ctx.dtMs;
+        if(sinceLogMs >= LOG_INTERVAL_MS) {
+            Serial.print("[LED] Sun idx:"); Serial.print(sunIndex);
+            Serial.print(" intensity:"); Serial.print(sunIntensity, 3);
+            Serial.print(" temp:"); Serial.println(sunTemp);
+            sinceLogMs = 0;
+        }
+    }
+
+private:
+    static constexpr uint8_t SUN_SOURCE = 0;
+    static constexpr uint8_t MOON_SOURCE = 1;
+    static constexpr uint8_t SUN_KERNEL_RADIUS = 8;   // Highlight width in LEDs (<= HighlightRenderer::MAX_KERNEL_RADIUS)
+    static constexpr uint8_t MOON_KERNEL_RADIUS = 4;
+    static constexpr uint32_t LOG_INTERVAL_MS = 5000;
+
+    HighlightRenderer highlights;
+    uint32_t sinceLogMs = 0;
+
+    float getSunColorTemp(float hourFloat) {
+        if (hourFloat < 6.0 || hourFloat > 18.5) {
+            return 0;
+        }
+        else if (hourFloat < 7.0) {
+            float t = (hourFloat - 6.0);
+            return 2000 + 2000 * t;
+        }
+        else if (hourFloat < 8.0) {
+            float t = (hourFloat - 7.0);
+            return 4000 + 1500 * t;
+        }
+        else if (hourFloat < 17.0) {
+            return 5500;
+        }
+        else if (hourFloat < 18.0) {
+            float t = (hourFloat - 17.0);
+            return 5500 - 1500 * t;
+        }
+        else {
+            float t = (hourFloat - 18.0);
+            return 4000 - 2000 * t;
+        }
+    }
+
+    int getSunPositionIndex(float hourFloat, int numLeds) {
+        // Continuous rotation around the cylinder over 24h so the sun keeps
+        // moving at night too (intensity is 0 then)
+        float wrappedHour = fmod(hourFloat + 24.0f, 24.0f);
+        float rotationFraction = fmod(wrappedHour / 24.0f, 1.0f); // 0..1 over 24h
+        return (int)(rotationFraction * numLeds) % numLeds;
+    }
+
+    float getSunIntensity(float hourFloat) {
+        // Simple elevation curve: zero at night, sine arch during daylight
+        if(hourFloat < 6.0f || hourFloat > 18.0f) return 0.0f;
+        float t = (hourFloat - 6.0f) / 12.0f; // 0 at 6h, 1 at 18h
+        float elev = sin(PI * t); // 0..1, peak at midday
+        if(elev < 0) elev = 0;
+        return elev;
+    }
+
+    float getMoonIntensity(float hourFloat) {
+        // Faint moon arch over the night (18h -> 6h), peak at midnight
+        if(hourFloat >= 6.0f && hourFloat <= 18.0f) return 0.0f;
+        float nightHour = hourFloat < 6.0f ? hourFloat + 24.0f : hourFloat;
+        float t = (nightHour - 18.0f) / 12.0f; // 0 at 18h, 1 at 6h
+        return 0.25f * sin(PI * t);
+    }
+};
+
+// ==================== Rain Effect ====================
+class RainEffect : public LEDEffect {
+public:
+    void init() override {
+        drops.begin(dropPool, DROP_CAPACITY, PARTICLE_PRESET_RAIN);
+        lightning.begin(boltPool, BOLT_CAPACITY, PARTICLE_PRESET_LIGHTNING);
+    }
+
+    void render(EffectContext& ctx) override {
+        CRGB* leds = ctx.leds;
+        int numLeds = ctx.numLeds;
+
+        // Base stormy sky - one generator step gives the jitter of all three channels
+        for(int i = 0; i < numLeds; i++) {
+            uint32_t noise = rng.next32();
+            leds[i] = CRGB(34 + EffectRandom::scaleByte(noise, 17),
+                           46 + EffectRandom::scaleByte(noise >> 8, 14),
+                           64 + EffectRandom::scaleByte(noise >> 16, 15));
+        }
+
+        drops.update(ctx.dtMs, numLeds, rng);
+        drops.render(leds, numLeds);
+        lightning.update(ctx.dtMs, numLeds, rng);
+        lightning.render(leds, numLeds);
+    }
+
+private:
+    static constexpr uint8_t DROP_CAPACITY = 32;
+    static constexpr uint8_t BOLT_CAPACITY = 2;
+
+    ParticleSystem drops;
+    ParticleSystem lightning;
+    Particle dropPool[DROP_CAPACITY];
+    Particle boltPool[BOLT_CAPACITY];
+};
+
+// ==================== Meteor Effect ====================
+class MeteorEffect : public LEDEffect {
+public:
+    void init() override {
+        meteors.begin(meteorPool, METEOR_CAPACITY, PARTICLE_PRESET_METEOR);
+    }
+
+    void render(EffectContext& ctx) override {
+        for(int i = 0; i < ctx.numLeds; i++) ctx.leds[i] = CRGB(0, 0, 0);
+
+        meteors.update(ctx.dtMs, ctx.numLeds, rng);
+        meteors.render(ctx.leds, ctx.numLeds);
+    }
+
+private:
+    static constexpr uint8_t METEOR_CAPACITY = 24;
+
+    ParticleSystem meteors;
+    Particle meteorPool[METEOR_CAPACITY];
+};
+
+// ==================== Apocalypse Effect ====================
+class ApocalypseEffect : public LEDEffect {
+public:
+    void render(EffectContext& ctx) override {
+        CRGB* leds = ctx.leds;
+        int numLeds = ctx.numLeds;
+
+        // Flicker, random bytes generated in batches. Green is a quarter of
+        // red's light output (x0.53 in perceptual units).
+        uint8_t noise[NOISE_BATCH];
+        for(int i = 0; i < numLeds; i += NOISE_BATCH) {
+            int count = min(NOISE_BATCH, numLeds - i);
+            rng.fill(noise, count);
+            for(int j = 0; j < count; j++) {
+                int flicker = 122 + EffectRandom::scaleByte(noise[j], 133);
+                leds[i + j] = CRGB(flicker, (flicker * 136) >> 8, 0);
+            }
+        }
+
+        // Smoke effect (darker patches, ~20% of frames)
+        if(rng.chance8(51)) {
+            int pos = rng.below(numLeds);
+            int width = rng.range(3, 8);
+            for(int i = pos; i < min(pos + width, numLeds); i++) {
+                leds[i].fadeToBlackBy(84);
+            }
+        }
+    }
+
+private:
+    static constexpr int NOISE_BATCH = 32;
+};
+
+// ==================== Registry ====================
+template <typename T>
+static LEDEffect* createEffect(void* storage) {
+    static_assert(sizeof(T) <= EFFECT_STATE_SIZE, "Effect too large for EffectSlot, raise EFFECT_STATE_SIZE");
+    return new (storage) T();
+}
+
+// Indexed by LEDMode - keep in enum order
+static const EffectInfo EFFECT_REGISTRY[LED_MODE_COUNT] = {
+    // mode                 name              label         frame ms  factory
+    {MODE_OFF,            "off",            "OFF",        100,      createEffect<OffEffect>},
+    {MODE_SKY_SIMULATION, "sky_simulation", "SKY",        50,       createEffect<SkySimulationEffect>},  // Changes on a minute scale
+    {MODE_RAIN,           "rain",           "RAIN",       20,       createEffect<RainEffect>},
+    {MODE_METEOR,         "meteor",         "METEOR",     20,       createEffect<MeteorEffect>},
+    {MODE_APOCALYPSE,     "apocalypse",     "APOCALYPSE", 30,       createEffect<ApocalypseEffect>},
+    {MODE_BASIC,          "basic",          "BASIC",      100,      createEffect<BasicEffect>},
+};
+
+const EffectInfo& getEffectInfo(LEDMode mode) {
+    if (mode < 0 || mode >= LED_MODE_COUNT) {
+        return EFFECT_REGISTRY[MODE_OFF];
+    }
+    return EFFECT_REGISTRY[mode];
+}
+
+const EffectInfo* findEffectByName(const char* name) {
+    if (name == nullptr) {
+        return nullptr;
+    }
+    for (int i = 0; i < LED_MODE_COUNT; i++) {
+        if (strcmp(EFFECT_REGISTRY[i].name, name) == 0) {
+            return &EFFECT_REGISTRY[i];
+        }
+    }
+    return nullptr;
+}
+
+// ==================== Effect Slot ====================
+EffectSlot::EffectSlot() {
+    effect = nullptr;
+    info = nullptr;
+}
+
+EffectSlot::~EffectSlot() {
+    release();
+}
+
+void EffectSlot::activate(const EffectInfo& newInfo, uint32_t seed) {
+    release();
+    effect = newInfo.create(storage);
+    info = &newInfo;
+    effect->seed(seed);
+    effect->init();
+}
+
+void EffectSlot::release() {
+    if (effect) {
+        effect->teardown();
+        effect->~LEDEffect();
+        effect = nullptr;
+        info = nullptr;
+    }
+}
+
+void EffectSlot::render(EffectContext& ctx) {
+    if (effect) {
+        effect->render(ctx);
+    }
+}
+
+const EffectInfo* EffectSlot::getInfo() {
+    return info;
+}
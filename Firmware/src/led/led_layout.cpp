@@ -0,0 +1,121 @@
+/**
+ * @file led_layout.cpp
+ * @brief LED layout persistence and buffer pool implementation
+ */
+
+#include <Preferences.h>
+#include <stdlib.h>
+#include "led_layout.h"
+#include "led_effects.h"
+
+#define LAYOUT_PREF_NAMESPACE "led-layout"
+#define LAYOUT_PREF_KEY "layout"
+#define LAYOUT_PREF_VERSION "version"
+#define LAYOUT_VERSION 1   // Bump when LEDLayout changes shape
+
+// ==================== Layout ====================
+void defaultLEDLayout(LEDLayout& layout) {
+    memset(&layout, 0, sizeof(layout));
+    layout.numLeds = NUM_LEDS;
+    layout.segmentCount = 1;
+    layout.segments[0].start = 0;
+    layout.segments[0].length = NUM_LEDS;
+    layout.segments[0].reversed = false;
+    layout.segments[0].mode = SEGMENT_FOLLOW_MODE;
+}
+
+bool validateLEDLayout(const LEDLayout& layout) {
+    if (layout.numLeds == 0 || layout.numLeds > LED_MAX_LEDS) {
+        return false;
+    }
+    if (layout.segmentCount == 0 || layout.segmentCount > LED_MAX_SEGMENTS) {
+        return false;
+    }
+    for (int i = 0; i < layout.segmentCount; i++) {
+        const LEDSegment& seg = layout.segments[i];
+        if (seg.length == 0 || seg.start + seg.length > layout.numLeds) {
+            return false;
+        }
+        if (seg.mode != SEGMENT_FOLLOW_MODE && seg.mode >= LED_MODE_COUNT) {
+            return false;
+        }
+        for (int j = 0; j < i; j++) {
+            const LEDSegment& other = layout.segments[j];
+            if (seg.start < other.start + other.length && other.start < seg.start + seg.length) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool loadLEDLayout(LEDLayout& layout) {
+    Preferences preferences;
+    preferences.begin(LAYOUT_PREF_NAMESPACE, true);
+    bool loaded = preferences.getUChar(LAYOUT_PREF_VERSION, 0) == LAYOUT_VERSION &&
+                  preferences.getBytes(LAYOUT_PREF_KEY, &layout, sizeof(layout)) == sizeof(layout) &&
+                  validateLEDLayout(layout);
+    preferences.end();
+    
+    if (!loaded) {
+        defaultLEDLayout(layout);
+        Serial.println("[LED] Using default layout (" + String(layout.numLeds) + " LEDs)");
+        return false;
+    }
+    Serial.println("[LED] Layout loaded: " + String(layout.numLeds) + " LEDs, " +
+                   String(layout.segmentCount) + " segment(s)");
+    return true;
+}
+
+bool saveLEDLayout(const LEDLayout& layout) {
+    if (!validateLEDLayout(layout)) {
+        return false;
+    }
+    Preferences preferences;
+    preferences.begin(LAYOUT_PREF_NAMESPACE, false);
+    bool saved = preferences.putBytes(LAYOUT_PREF_KEY, &layout, sizeof(layout)) == sizeof(layout) &&
+                 preferences.putUChar(LAYOUT_PREF_VERSION, LAYOUT_VERSION) == 1;
+    preferences.end();
+    return saved;
+}
+
+// ==================== Buffer Pool ====================
+LEDBufferPool::LEDBufferPool() {
+    memory = nullptr;
+    capacity = 0;
+    used = 0;
+}
+
+LEDBufferPool::~LEDBufferPool() {
+    free(memory);
+}
+
+bool LEDBufferPool::allocate(size_t ledCount) {
+    if (memory != nullptr) {
+        return ledCount <= capacity;  // Already allocated - sized once at startup
+    }
+    memory = (CRGB*)calloc(ledCount, sizeof(CRGB));
+    if (memory == nullptr) {
+        return false;
+    }
+    capacity = ledCount;
+    used = 0;
+    return true;
+}
+
+CRGB* LEDBufferPool::take(size_t ledCount) {
+    if (memory == nullptr || used + ledCount > capacity) {
+        return nullptr;
+    }
+    CRGB* slice = memory + used;
+    used += ledCount;
+    return slice;
+}
+
+size_t LEDBufferPool::getCapacity() {
+    return capacity;
+}
+
+size_t LEDBufferPool::getUsed() {
+    return used;
+}
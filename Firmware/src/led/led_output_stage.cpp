@@ -0,0 +1,65 @@
+/**
+ * @file led_output_stage.cpp
+ * @brief Gamma/brightness/dither output stage implementation
+ */
+
+#include "led_output_stage.h"
+#include "gamma_table.h"
+
+// Bit-reversed counter: consecutive frames get thresholds far apart, so the
+// extra on-frames of a dithered pixel are spread evenly over the cycle
+static const uint8_t DITHER_THRESHOLDS[16] = {
+    0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15
+};
+
+LEDOutputStage::LEDOutputStage() {
+    brightness = 255;
+    ditherBits = 0;
+    phase = 0;
+    rebuild();
+}
+
+void LEDOutputStage::configure(uint8_t newBrightness, uint8_t newDitherBits) {
+    if (newDitherBits > MAX_DITHER_BITS) {
+        newDitherBits = MAX_DITHER_BITS;
+    }
+    if (newBrightness == brightness && newDitherBits == ditherBits) {
+        return;
+    }
+    brightness = newBrightness;
+    ditherBits = newDitherBits;
+    rebuild();
+}
+
+void LEDOutputStage::rebuild() {
+    // 8.8 gamma value scaled by brightness/256, keeping ditherBits of fraction.
+    // Brightness 0..255 maps onto 0..256: 0 stays all zero (a dither threshold
+    // would otherwise light the top entries), and 255 at full brightness maps
+    // to exactly 255 << ditherBits, so adding a threshold never carries past 255.
+    uint32_t scale = (uint32_t)brightness + (brightness >> 7);
+    for (int i = 0; i < 256; i++) {
+        lut[i] = ((uint32_t)GAMMA_TABLE[i] * scale) >> (16 - ditherBits);
+    }
+}
+
+bool LEDOutputStage::apply(const CRGB* frame, CRGB* output, int numLeds) {
+    const uint8_t shift = ditherBits;
+    const uint8_t mask = (1 << shift) - 1;
+    const uint8_t step = 4 - shift;   // Threshold table is 4-bit, use its top bits
+    uint16_t residue = 0;
+    
+    for (int i = 0; i < numLeds; i++) {
+        // Offset the cycle per pixel so neighbours don't switch on the same frame
+        uint16_t threshold = DITHER_THRESHOLDS[(phase + i * 7) & 0x0F] >> step;
+        uint16_t r = lut[frame[i].r];
+        uint16_t g = lut[frame[i].g];
+        uint16_t b = lut[frame[i].b];
+        residue |= r | g | b;
+        output[i].r = (r + threshold) >> shift;
+        output[i].g = (g + threshold) >> shift;
+        output[i].b = (b + threshold) >> shift;
+    }
+    phase++;
+    
+    return (residue & mask) != 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file led_pipeline.cpp
+ * @brief Double-buffered LED render pipeline implementation
+ */
+
+#include "led_pipeline.h"
+
+RenderPipeline::RenderPipeline() {
+    sink = nullptr;
+    numLeds = 0;
+    front = nullptr;
+    back = nullptr;
+    output = nullptr;
+    backBrightness = DEFAULT_BRIGHTNESS;
+    frameReady = false;
+    ditherPending = false;
+    stats = {0, 0, 0, 0};
+    periodMs = LED_OUTPUT_INTERVAL_MS;
+#ifdef ESP32
+    swapLock = portMUX_INITIALIZER_UNLOCKED;
+    taskHandle = nullptr;
+#else
+    running = false;
+#endif
+}
+
+RenderPipeline::~RenderPipeline() {
+    stopTask();
+}
+
+bool RenderPipeline::begin(LEDSink* outputSink, int leds, LEDBufferPool& pool) {
+    if (outputSink == nullptr) {
+        return false;
+    }
+    front = pool.take(leds);
+    back = pool.take(leds);
+    output = pool.take(leds);
+    if (front == nullptr || back == nullptr || output == nullptr) {
+        return false;
+    }
+    sink = outputSink;
+    numLeds = leds;
+    return sink->begin(numLeds, pool);
+}
+
+void RenderPipeline::lock() {
+#ifdef ESP32
+    portENTER_CRITICAL(&swapLock);
+#else
+    swapLock.lock();
+#endif
+}
+
+void RenderPipeline::unlock() {
+#ifdef ESP32
+    portEXIT_CRITICAL(&swapLock);
+#else
+    swapLock.unlock();
+#endif
+}
+
+void RenderPipeline::submit(const CRGB* frame, uint8_t brightness) {
+    // Only the copy happens under the lock; the output task holds it just
+    // long enough to swap two pointers
+    lock();
+    if (frameReady) {
+        stats.overwritten++;
+    }
+    memcpy(back, frame, numLeds * sizeof(CRGB));
+    backBrightness = brightness;
+    frameReady = true;
+    stats.submitted++;
+    unlock();
+}
+
+void RenderPipeline::service() {
+    if (sink == nullptr) {
+        return;
+    }
+    
+    uint8_t brightness = 0;
+    lock();
+    bool fresh = frameReady;
+    if (fresh) {
+        CRGB* tmp = front;
+        front = back;
+        back = tmp;
+        brightness = backBrightness;
+        frameReady = false;
+    }
+    unlock();
+    
+    if (!fresh && !ditherPending) {
+        return;
+    }
+    if (fresh) {
+        outputStage.configure(brightness, LED_DITHER_BITS);
+    }
+    
+    // Front buffer belongs to the output side until the next swap
+    ditherPending = outputStage.apply(front, output, numLeds);
+    sink->show(output, numLeds);
+    
+    // getStats() copies under the lock from the renderer's side
+    lock();
+    if (!fresh) {
+        stats.refreshed++;
+    }
+    stats.shown++;
+    unlock();
+}
+
+LEDPipelineStats RenderPipeline::getStats() {
+    lock();
+    LEDPipelineStats copy = stats;
+    unlock();
+    return copy;
+}
+
+#ifdef ESP32
+void RenderPipeline::taskEntry(void* arg) {
+    RenderPipeline* pipeline = (RenderPipeline*)arg;
+    TickType_t lastWake = xTaskGetTickCount();
+    TickType_t period = pdMS_TO_TICKS(pipeline->periodMs);
+    if (period == 0) {
+        period = 1;
+    }
+    
+    for (;;) {
+        pipeline->service();
+        vTaskDelayUntil(&lastWake, period);
+    }
+}
+
+bool RenderPipeline::startTask(int core, uint32_t period) {
+    if (taskHandle != nullptr) {
+        return true;
+    }
+    periodMs = period;
+    BaseType_t result = xTaskCreatePinnedToCore(taskEntry, "led_output", 4096, this,
+                                                configMAX_PRIORITIES - 2, &taskHandle, core);
+    if (result != pdPASS) {
+        taskHandle = nullptr;
+        Serial.println("[LED] ERROR: Failed to start output task");
+        return false;
+    }
+    Serial.println("[LED] Output task started on core " + String(core));
+    return true;
+}
+
+void RenderPipeline::stopTask() {
+    if (taskHandle != nullptr) {
+        vTaskDelete(taskHandle);
+        taskHandle = nullptr;
+    }
+}
+#else
+bool RenderPipeline::startTask(int, uint32_t period) {   // No core pinning on the host
+    if (running) {
+        return true;
+    }
+    periodMs = period;
+    running = true;
+    // Paced by the (virtual) micros() clock the renderer runs on, like the
+    // tick-based vTaskDelayUntil() on the board
+    outputThread = std::thread([this]() {
+        unsigned long scheduledUs = micros();
+        while (running) {
+            service();
+            scheduledUs += periodMs * 1000UL;
+            while (running && (long)(micros() - scheduledUs) < 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+    });
+    return true;
+}
+
+void RenderPipeline::stopTask() {
+    if (running) {
+        running = false;
+        outputThread.join();
+    }
+}
+#endif
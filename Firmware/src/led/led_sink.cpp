@@ -0,0 +1,87 @@
+/**
+ * @file led_sink.cpp
+ * @brief LED output sink implementations
+ */
+
+#include "led_sink.h"
+
+// ==================== FastLED Sink ====================
+bool FastLEDSink::begin(int leds, LEDBufferPool& pool) {
+    output = pool.take(leds);
+    if (output == nullptr) {
+        return false;
+    }
+    numLeds = leds;
+    // No show() here: the RMT driver binds its interrupt to the core of the
+    // first show(), which must be the output task's core
+    FastLED.addLeds<LED_TYPE, LED_PIN, COLOR_ORDER>(output, numLeds);
+    // Brightness and dithering happen in LEDOutputStage - FastLED passes frames through
+    FastLED.setBrightness(255);
+    FastLED.setDither(DISABLE_DITHER);
+    return true;
+}
+
+void FastLEDSink::show(const CRGB* frame, int frameLeds) {
+    if (frameLeds > numLeds) {
+        frameLeds = numLeds;
+    }
+    memcpy(output, frame, frameLeds * sizeof(CRGB));
+    FastLED.show();
+}
+
+// ==================== Recording Sink ====================
+bool RecordingSink::begin(int, LEDBufferPool&) {   // Keeps no frame, needs no buffer
+    frameCount = 0;
+    lastFrameHash = 0;
+    historyIndex = 0;
+    minInterval = 0xFFFFFFFF;
+    maxInterval = 0;
+    for (int i = 0; i < HISTORY_SIZE; i++) {
+        intervals[i] = 0;
+    }
+    return true;
+}
+
+void RecordingSink::show(const CRGB* frame, int numLeds) {
+    unsigned long nowUs = micros();
+    
+    if (frameCount > 0) {
+        uint32_t interval = nowUs - lastShowUs;
+        intervals[historyIndex] = interval;
+        historyIndex = (historyIndex + 1) % HISTORY_SIZE;
+        if (interval < minInterval) minInterval = interval;
+        if (interval > maxInterval) maxInterval = interval;
+    }
+    lastShowUs = nowUs;
+    frameCount++;
+    
+    const uint8_t* bytes = (const uint8_t*)frame;
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < numLeds * sizeof(CRGB); i++) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    lastFrameHash = hash;
+}
+
+uint32_t RecordingSink::getFrameCount() {
+    return frameCount;
+}
+
+uint32_t RecordingSink::getLastFrameHash() {
+    return lastFrameHash;
+}
+
+uint32_t RecordingSink::getInterval(int age) {
+    if (age < 0 || age >= HISTORY_SIZE) {
+        return 0;
+    }
+    return intervals[(historyIndex - 1 - age + 2 * HISTORY_SIZE) % HISTORY_SIZE];
+}
+
+uint32_t RecordingSink::getMinInterval() {
+    return frameCount > 1 ? minInterval : 0;
+}
+
+uint32_t RecordingSink::getMaxInterval() {
+    return maxInterval;
+}
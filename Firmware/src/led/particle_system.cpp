@@ -0,0 +1,186 @@
+/**
+ * @file particle_system.cpp
+ * @brief Fixed-capacity 1D particle engine implementation
+ */
+
+#include "particle_system.h"
+
+// One spawn in the units of spawnRate (8.8) x dtMs x numLeds: 256 * 1000 ms * 100 LEDs
+static constexpr uint32_t SPAWN_UNIT = 25600000UL;
+// Credit is capped so a long frame gap doesn't release a burst
+static constexpr uint32_t MAX_SPAWN_CREDIT = 8 * SPAWN_UNIT;
+
+// Meteor trail, head first: light falling off as 1/(j+1) and tapering to
+// zero at the end, in perceptual units. Trails shorter than MAX_SIZE sample it.
+static const uint8_t TRAIL_FALLOFF[ParticleSystem::MAX_SIZE] = {
+    255, 181, 146, 124, 108, 95, 85, 76, 69, 61, 55, 49, 42, 36, 29, 21,
+};
+
+static uint8_t clampSize(uint8_t size) {
+    if (size < 1) return 1;
+    return size > ParticleSystem::MAX_SIZE ? ParticleSystem::MAX_SIZE : size;
+}
+
+// ==================== Presets ====================
+//                                            rate/100   life ms     speed     colour                jitter shape           size spawn
+const ParticlePreset PARTICLE_PRESET_METEOR    = {1536, 1500, 3000,  40, 60,  CRGB(255, 228, 167), 40,  PARTICLE_TRAIL, 8,   SPAWN_ANYWHERE};
+const ParticlePreset PARTICLE_PRESET_RAIN      = {6400, 150,  400,   8,  20,  CRGB(40, 60, 90),    80,  PARTICLE_TRAIL, 3,   SPAWN_ANYWHERE};
+const ParticlePreset PARTICLE_PRESET_LIGHTNING = {77,   60,   110,   0,  0,   CRGB(235, 235, 255), 0,   PARTICLE_GLOW,  15,  SPAWN_MIDDLE};
+
+// ==================== Particle System ====================
+ParticleSystem::ParticleSystem() {
+    pool = nullptr;
+    capacity = 0;
+    count = 0;
+    preset = nullptr;
+    spawnRate = 0;
+    spawnCredit = 0;
+    nextSpawnCost = SPAWN_UNIT;
+}
+
+void ParticleSystem::begin(Particle* particles, uint8_t size, const ParticlePreset& newPreset) {
+    pool = particles;
+    capacity = size;
+    preset = &newPreset;
+    spawnRate = newPreset.spawnRate;
+    clear();
+}
+
+void ParticleSystem::clear() {
+    count = 0;
+    spawnCredit = 0;
+    nextSpawnCost = SPAWN_UNIT;
+}
+
+void ParticleSystem::setSpawnRate(uint16_t rate) {
+    spawnRate = rate;
+}
+
+uint16_t ParticleSystem::getSpawnRate() {
+    return spawnRate;
+}
+
+uint8_t ParticleSystem::getActiveCount() {
+    return count;
+}
+
+bool ParticleSystem::spawn(int numLeds, EffectRandom& rng) {
+    if (count >= capacity || numLeds <= 0) {
+        return false;
+    }
+
+    Particle& p = pool[count++];
+    int32_t head;
+    if (preset->spawn == SPAWN_MIDDLE) {
+        head = rng.range(numLeds / 3, numLeds * 2 / 3);
+    } else {
+        head = rng.below(numLeds);
+    }
+    p.pos = head << 16;
+    p.vel = rng.range(preset->speedMin * 256, preset->speedMax * 256 + 1);
+
+    // Linear fade over the life - one division here instead of one per frame
+    uint16_t lifeMs = rng.range(preset->lifeMinMs, preset->lifeMaxMs + 1);
+    p.energy = 0xFFFF;
+    p.decay = lifeMs > 0 ? 0xFFFF / lifeMs : 0xFFFF;
+
+    p.color = preset->color;
+    if (preset->colorJitter) {
+        p.color.nscale8(255 - EffectRandom::scaleByte(rng.next32() >> 24, preset->colorJitter));
+    }
+    return true;
+}
+
+void ParticleSystem::kill(uint8_t index) {
+    pool[index] = pool[--count];
+}
+
+void ParticleSystem::update(uint32_t dtMs, int numLeds, EffectRandom& rng) {
+    if (pool == nullptr || numLeds <= 0) {
+        return;
+    }
+    if (dtMs > MAX_STEP_MS) {
+        dtMs = MAX_STEP_MS;
+    }
+
+    // Spawn from the rate. Each spawn costs a random 0.5-1.5 units so the
+    // intervals vary while the average rate holds; spawns into a full pool
+    // are dropped rather than queued.
+    uint64_t credit = spawnCredit + (uint64_t)spawnRate * dtMs * numLeds;
+    spawnCredit = credit > MAX_SPAWN_CREDIT ? MAX_SPAWN_CREDIT : (uint32_t)credit;
+    while (spawnCredit >= nextSpawnCost) {
+        spawnCredit -= nextSpawnCost;
+        nextSpawnCost = SPAWN_UNIT / 2 + rng.below(SPAWN_UNIT);
+        spawn(numLeds, rng);
+    }
+
+    // Frame time as a 16.16 fraction of a second: vel (8.8) * step >> 8 = 16.16 LEDs
+    int32_t step = (int32_t)((dtMs << 16) / 1000);
+    int32_t margin = preset->size;
+    uint8_t i = 0;
+    while (i < count) {
+        Particle& p = pool[i];
+        uint32_t loss = (uint32_t)p.decay * dtMs;
+        p.pos += (int32_t)(((int64_t)p.vel * step) >> 8);
+        int32_t head = p.pos >> 16;
+        if (loss >= p.energy || head < -margin || head >= numLeds + margin) {
+            kill(i);  // Re-check the particle swapped into this index
+            continue;
+        }
+        p.energy -= loss;
+        i++;
+    }
+}
+
+void ParticleSystem::render(CRGB* leds, int numLeds) {
+    for (uint8_t i = 0; i < count; i++) {
+        const Particle& p = pool[i];
+        CRGB color = p.color;
+        color.nscale8(p.energy >> 8);
+
+        if (preset->shape == PARTICLE_TRAIL) {
+            drawTrail(p, color, leds, numLeds);
+        } else if (preset->shape == PARTICLE_GLOW) {
+            drawGlow(p, color, leds, numLeds);
+        } else {
+            int32_t head = p.pos >> 16;
+            if (head >= 0 && head < numLeds) {
+                leds[head] += color;
+            }
+        }
+    }
+}
+
+void ParticleSystem::drawTrail(const Particle& p, CRGB color, CRGB* leds, int numLeds) {
+    int32_t head = p.pos >> 16;
+    int32_t dir = p.vel >= 0 ? -1 : 1;  // Tail points back along the motion
+    uint8_t length = clampSize(preset->size);
+    uint16_t tableStep = (MAX_SIZE << 8) / length;  // 8.8 step through TRAIL_FALLOFF
+
+    uint16_t tablePos = 0;
+    for (uint8_t j = 0; j < length; j++, tablePos += tableStep) {
+        int32_t index = head + dir * j;
+        if (index >= 0 && index < numLeds) {
+            CRGB c = color;
+            leds[index] += c.nscale8(TRAIL_FALLOFF[tablePos >> 8]);
+        }
+    }
+}
+
+void ParticleSystem::drawGlow(const Particle& p, CRGB color, CRGB* leds, int numLeds) {
+    int32_t center = p.pos >> 16;
+    uint8_t radius = clampSize(preset->size);
+    uint16_t weightStep = 0xFF00 / radius;  // Linear falloff to zero at the radius, 8.8
+
+    uint16_t weight = 0xFF00;
+    for (uint8_t d = 0; d < radius; d++, weight -= weightStep) {
+        CRGB c = color;
+        c.nscale8(weight >> 8);
+        if (center + d >= 0 && center + d < numLeds) {
+            leds[center + d] += c;
+        }
+        if (d > 0 && center - d >= 0 && center - d < numLeds) {
+            leds[center - d] += c;
+        }
+    }
+}
@@ -19,27 +19,44 @@
 #include "ds18b20_sensor.h"
 #include "led_controller.h"
 #include "mqtt_handler.h"
+#include "publish_policy.h"
+#include "sensor_snapshot.h"
+#include "sensor_task.h"
+#include "telemetry_batch.h"
+#include "telemetry_store.h"
 #include "turbidity_sensor.h"
+#include "window_aggregator.h"
 
 // ==================== Global Objects ====================
 LEDController ledController;
 ld2410 radar;
 TurbiditySensor turbiditySensor(TURBIDITY_SENSOR_PIN);
 DS18B20Sensor temperatureSensor(DS18B20_PIN);
+SensorTask sensorTask;   // Owns both sensors once started
+PublishPolicy publishPolicy;
+WindowAggregator telemetryWindow;   // Every snapshot since the last sensor message
+TelemetryBatch telemetryBatch;      // Records waiting for the next batch message
+TelemetryStore telemetryStore;      // Records that could not be sent, for replay
 MQTTHandler mqttHandler;
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 
 // ==================== Timing Variables ====================
-unsigned long lastSensorRead = 0;
-unsigned long lastDataSend = 0;
 unsigned long lastLEDStatusPublish = 0;
 unsigned long lastDisplayUpdate = 0;
+unsigned long lastTelemetryReplay = 0;
+unsigned long lastStatsLog = 0;
+const unsigned long STATS_LOG_INTERVAL = 10000; // Print diagnostics every 10 s
+
+// ==================== Loop Latency ====================
+// Time spent in loop() before the closing delay, reset by logStats() every
+// STATS_LOG_INTERVAL so each average covers the same span
+unsigned long loopMaxUs = 0;
+unsigned long loopTotalUs = 0;
+unsigned long loopCount = 0;
 
 // ==================== Sensor Data ====================
-float currentTemperature = 0.0;
-float currentTurbidity = 0.0;
-String currentWaterQuality = "Unknown";
-float currentPH = 7.0;
+// Replaced as a whole once per SENSOR_READ_INTERVAL, only read in between
+SensorSnapshot sensorSnapshot = {};
 
 // ==================== LED State ====================
 LEDMode lastLEDMode = MODE_OFF;
@@ -57,14 +74,22 @@ void setupWiFi();
 void setupNTP();
 void setupRadar();
 void setupOLED();
-void readSensors();
-void publishSensorData();
+void drainSensorSnapshots();
+bool publishSensorData(const SensorSnapshot& snapshot, const TelemetrySummary& summary);
+void addMetricSummary(JsonObject target, const MetricSummary& metric);
+bool publishTelemetryBatch();
+void replayTelemetryBacklog();
 void publishLEDStatus();
+void logStats();
 void publishRadarStatus();
-void updateDisplay();
+void updateDisplay(const SensorSnapshot& snapshot);
 void mqttCallback(char *topic, uint8_t *payload, unsigned int length);
 void handleLEDControl(JsonDocument &doc);
 void handleRadarControl(JsonDocument &doc);
+void handleSensorControl(JsonDocument &doc);
+bool readLayoutValue(JsonVariant value, long fallback, long minValue, const char *name, uint16_t &out);
+void handleLEDLayout(JsonObject layoutJson);
+void handleLEDLayer(JsonObject layerJson);
 void checkRadarAndControlLED();
 void parseHexColor(const char *hexColor, uint8_t &r, uint8_t &g, uint8_t &b);
 float simulatePH();
@@ -87,16 +112,18 @@ void setup() {
   // Setup OLED Display
   setupOLED();
 
-  // Configure ADC for turbidity sensor
+  // Configure one-shot ADC reads (the turbidity sensor samples in continuous mode)
   analogReadResolution(12);
   analogSetAttenuation(ADC_11db);
-  // Also set per-pin attenuation to ensure correct range on selected pin
-  analogSetPinAttenuation(TURBIDITY_SENSOR_PIN, ADC_11db);
 
-  // Initialize random seed for pH simulation
+  // Initialize random seed for pH simulation and the LED effects
   randomSeed(analogRead(0));
+  ledController.setEffectSeed(random(0x7FFFFFFF));
 
-  // Initialize LED Controller
+  // Initialize LED Controller (strip length and segments from Preferences)
+  LEDLayout ledLayout;
+  loadLEDLayout(ledLayout);
+  ledController.setLayout(ledLayout);
   if (!ledController.init()) {
     Serial.println("[ERROR] LED Controller initialization failed!");
   }
@@ -117,12 +144,25 @@ void setup() {
     Serial.println("[ERROR] Turbidity Sensor initialization failed!");
   }
 
+  // Sample both sensors from their own task from here on. The host build
+  // runs on a virtual clock that only loop() advances, so there the task
+  // cycle runs inline in loop() instead.
+  sensorTask.begin(&temperatureSensor, &turbiditySensor, simulatePH);
+#ifdef ESP32
+  if (!sensorTask.startTask(SENSOR_TASK_CORE, SENSOR_TASK_PERIOD_MS)) {
+    Serial.println("[ERROR] Sensor task failed to start - sampling from loop()");
+  }
+#endif
+
+  // Records from an outage before the last reboot are replayed once MQTT is up
+  telemetryStore.begin();
+
   // Initialize MQTT
   if (!mqttHandler.init()) {
     Serial.println("[ERROR] MQTT initialization failed!");
   }
   mqttHandler.setCallback(mqttCallback);
-  mqttHandler.connect();
+  mqttHandler.connect();   // Starts on the first loop(), without blocking it
 
   // Set default LED mode
   ledController.setMode(MODE_OFF); // Start with LED off
@@ -134,6 +174,7 @@ void setup() {
 
 // ==================== Main Loop ====================
 void loop() {
+  unsigned long loopStartUs = micros();
   unsigned long currentMillis = millis();
 
   // Update radar sensor
@@ -151,22 +192,35 @@ void loop() {
   // Handle MQTT
   mqttHandler.loop();
 
-  // Read sensors periodically
-  if (currentMillis - lastSensorRead >= SENSOR_READ_INTERVAL) {
-    lastSensorRead = currentMillis;
-    readSensors();
+  // Take the snapshots the sensor task queued since the last loop
+  if (!sensorTask.isRunning()) {
+    sensorTask.service();
+  }
+  drainSensorSnapshots();
+  if (telemetryBatch.isDue(currentMillis)) {
+    publishTelemetryBatch();
   }
 
-  // Send data to MQTT server periodically
-  if (currentMillis - lastDataSend >= DATA_SEND_INTERVAL) {
-    lastDataSend = currentMillis;
-    publishSensorData();
+  // Store-and-forward: the backlog goes out in small batches next to live data
+  telemetryStore.service(currentMillis);
+  if (telemetryStore.hasBacklog() && mqttHandler.isConnected() &&
+      currentMillis - lastTelemetryReplay >= TELEMETRY_REPLAY_INTERVAL_MS) {
+    lastTelemetryReplay = currentMillis;
+    replayTelemetryBacklog();
   }
 
   // Update OLED display periodically
   if (currentMillis - lastDisplayUpdate >= DISPLAY_UPDATE_INTERVAL) {
     lastDisplayUpdate = currentMillis;
-    updateDisplay();
+    updateDisplay(sensorSnapshot);
+  }
+
+  // Diagnostics on their own fixed period: the per-interval maxima (sensor
+  // task late/busy, loop time) reset on every read, so each line covers
+  // the same window
+  if (currentMillis - lastStatsLog >= STATS_LOG_INTERVAL) {
+    lastStatsLog = currentMillis;
+    logStats();
   }
 
   // Publish LED status if mode or brightness changed
@@ -178,6 +232,13 @@ void loop() {
     publishLEDStatus();
   }
 
+  unsigned long loopUs = micros() - loopStartUs;
+  loopTotalUs += loopUs;
+  loopCount++;
+  if (loopUs > loopMaxUs) {
+    loopMaxUs = loopUs;
+  }
+
   // Small delay to prevent watchdog issues
   delay(10);
 }
@@ -260,48 +321,102 @@ void setupRadar() {
   }
 }
 
-// ==================== Read Sensors ====================
-void readSensors() {
-  // Read temperature
-  currentTemperature = temperatureSensor.readTemperature();
-  if (currentTemperature != DEVICE_DISCONNECTED_C) {
-    Serial.print("[Sensor] Temperature: ");
-    Serial.print(currentTemperature);
-    Serial.println(" °C");
-  } else {
-    Serial.println("[Sensor] Temperature: ERROR - Sensor disconnected");
-  }
+// ==================== Drain Sensor Snapshots ====================
+void drainSensorSnapshots() {
+  SensorSnapshot snapshot;
+  while (sensorTask.poll(snapshot)) {
+    sensorSnapshot = snapshot;
 
-  // Read turbidity
-  currentTurbidity = turbiditySensor.readNTU();
-  currentWaterQuality = turbiditySensor.getWaterQuality();
+    if (snapshot.temperatureCount == 0) {
+      Serial.println("[Sensor] Temperature: ERROR - Sensor disconnected");
+    } else {
+      Serial.print("[Sensor] Temperature:");
+      for (uint8_t i = 0; i < snapshot.temperatureCount; i++) {
+        Serial.print(" ");
+        if (snapshot.temperatures[i].valid) {
+          Serial.print(snapshot.temperatures[i].celsius);
+        } else {
+          Serial.print("--");
+        }
+      }
+      Serial.println(" °C");
+    }
 
-  Serial.print("[Sensor] Turbidity: ");
-  Serial.print(currentTurbidity);
-  Serial.print(" NTU (");
-  Serial.print(currentWaterQuality);
-  Serial.println(")");
+    Serial.print("[Sensor] Turbidity: ");
+    Serial.print(snapshot.turbidity.ntu);
+    Serial.print(" NTU (");
+    Serial.print(getWaterQualityName(snapshot.turbidity.quality));
+    Serial.println(")");
 
-  // Simulate pH reading
-  currentPH = simulatePH();
-  Serial.print("[Sensor] pH: ");
-  Serial.println(currentPH, 2);
+    Serial.print("[Sensor] pH: ");
+    Serial.println(snapshot.ph, 2);
+
+    // Send on change, or as a heartbeat when nothing moved. The message
+    // summarises every snapshot since the previous one.
+    telemetryWindow.add(snapshot);
+    PublishReason reason = publishPolicy.evaluate(snapshot);
+    if (reason != PUBLISH_NONE && telemetryBatch.isEnabled()) {
+      // Queued for the next batch message; loop() sends it when due
+      telemetryBatch.add(makeTelemetryRecord(snapshot, telemetryWindow.summarize()));
+      publishPolicy.markSent(snapshot, reason);
+      telemetryWindow.reset();
+    } else if (reason != PUBLISH_NONE) {
+      TelemetrySummary summary = telemetryWindow.summarize();
+      if (publishSensorData(snapshot, summary)) {
+        publishPolicy.markSent(snapshot, reason);
+        Serial.print("[Data] Sensor data published (");
+      } else {
+        // Offline: kept for replay, so the deadbands move on as if it was sent
+        telemetryStore.add(makeTelemetryRecord(snapshot, summary));
+        publishPolicy.markStored(snapshot);
+        Serial.print("[Data] Sensor data stored for replay (");
+      }
+      telemetryWindow.reset();
+      Serial.print(PublishPolicy::getReasonName(reason));
+      Serial.println(")");
+    }
+  }
 }
 
 // ==================== Publish Sensor Data ====================
-void publishSensorData() {
+bool publishSensorData(const SensorSnapshot& snapshot, const TelemetrySummary& summary) {
   if (!mqttHandler.isConnected()) {
-    Serial.println("[MQTT] Not connected - skipping sensor data publish");
-    return;
+    return false;
   }
 
-  // Create JSON document with all sensor data
-  StaticJsonDocument<256> doc;
-  doc["temperature"] = currentTemperature;
-  doc["turbidity"] = currentTurbidity;
-  doc["water_quality"] = currentWaterQuality;
-  doc["ph"] = currentPH;
-  doc["timestamp"] = millis();
+  // Top-level values are the window means (the readings themselves when a
+  // sensor had no valid reading in the window); "window" holds the details
+  StaticJsonDocument<1536> doc;
+  const MetricSummary &temperature = summary.temperatures[0];
+  doc["temperature"] = temperature.count > 0 ? temperature.mean : snapshot.temperatures[0].celsius;
+  if (summary.temperatureCount > 1) {
+    // One entry per probe slot, null while a probe had no reading
+    JsonArray temperatures = doc.createNestedArray("temperatures");
+    for (uint8_t i = 0; i < summary.temperatureCount; i++) {
+      if (summary.temperatures[i].count > 0) {
+        temperatures.add(summary.temperatures[i].mean);
+      } else {
+        temperatures.add(nullptr);
+      }
+    }
+  }
+  doc["turbidity"] = summary.turbidity.count > 0 ? summary.turbidity.mean : snapshot.turbidity.ntu;
+  doc["water_quality"] = getWaterQualityName(snapshot.turbidity.quality);
+  doc["ph"] = summary.ph.count > 0 ? summary.ph.mean : snapshot.ph;
+  doc["timestamp"] = snapshot.timestampMs;
+
+  JsonObject window = doc.createNestedObject("window");
+  window["start"] = summary.startMs;
+  window["samples"] = summary.snapshots;
+  addMetricSummary(window.createNestedObject("temperature"), temperature);
+  if (summary.temperatureCount > 1) {
+    JsonArray probes = window.createNestedArray("temperatures");
+    for (uint8_t i = 0; i < summary.temperatureCount; i++) {
+      addMetricSummary(probes.createNestedObject(), summary.temperatures[i]);
+    }
+  }
+  addMetricSummary(window.createNestedObject("turbidity"), summary.turbidity);
+  addMetricSummary(window.createNestedObject("ph"), summary.ph);
 
   String jsonString;
   serializeJson(doc, jsonString);
@@ -309,11 +424,85 @@ void publishSensorData() {
   // Publish to MQTT
   bool success = mqttHandler.publishMessage(MQTT_TOPIC_SENSOR_DATA, jsonString.c_str());
 
-  if (success) {
-    Serial.println("[Data] Sensor data published successfully");
-  } else {
+  if (!success) {
     Serial.println("[Data] Failed to publish sensor data");
   }
+  return success;
+}
+
+void addMetricSummary(JsonObject target, const MetricSummary& metric) {
+  target["count"] = metric.count;
+  if (metric.count == 0) {
+    return;
+  }
+  target["min"] = metric.min;
+  target["max"] = metric.max;
+  target["mean"] = metric.mean;
+  target["stddev"] = metric.stddev;
+  target["last"] = metric.last;
+}
+
+// ==================== Publish Telemetry Batch ====================
+bool publishTelemetryBatch() {
+  uint16_t records = telemetryBatch.getCount();
+  String jsonString;
+  bool published = false;
+  if (mqttHandler.isConnected()) {
+    DynamicJsonDocument doc(telemetryBatch.jsonCapacity());
+    telemetryBatch.toJson(doc);
+    doc["boot"] = telemetryStore.getBoot();
+    serializeJson(doc, jsonString);
+    published = mqttHandler.publishMessage(MQTT_TOPIC_SENSOR_BATCH, jsonString.c_str());
+  }
+
+  if (!published) {
+    // Kept for replay once the broker is back
+    const TelemetryRecord *queued = telemetryBatch.getRecords();
+    for (uint16_t i = 0; i < records; i++) {
+      telemetryStore.add(queued[i]);
+    }
+    telemetryBatch.clear();
+    Serial.print("[Data] Sensor batch stored for replay (");
+    Serial.print(records);
+    Serial.println(" records)");
+    return false;
+  }
+  telemetryBatch.markSent();
+  Serial.print("[Data] Sensor batch published (");
+  Serial.print(records);
+  Serial.print(" records, ");
+  Serial.print(jsonString.length());
+  Serial.println(" bytes)");
+  return true;
+}
+
+// ==================== Replay Stored Telemetry ====================
+// One batch of the oldest stored records per call, in the batch message
+// format with "replay": true and the boot the timestamps belong to
+void replayTelemetryBacklog() {
+  static TelemetryRecord records[TELEMETRY_REPLAY_BATCH];
+  uint32_t boot = 0;
+  uint16_t count = telemetryStore.peek(records, TELEMETRY_REPLAY_BATCH, boot);
+  if (count == 0) {
+    return;
+  }
+
+  DynamicJsonDocument doc(TelemetryBatch::jsonCapacity(records, count));
+  TelemetryBatch::toJson(doc, records, count);
+  doc["boot"] = boot;
+  doc["replay"] = true;
+
+  String jsonString;
+  serializeJson(doc, jsonString);
+  if (!mqttHandler.publishMessage(MQTT_TOPIC_SENSOR_BATCH, jsonString.c_str())) {
+    return;   // Still stored; retried after TELEMETRY_REPLAY_INTERVAL_MS
+  }
+  telemetryStore.consume(count);
+  Serial.print("[Store] Replayed ");
+  Serial.print(count);
+  Serial.print(" records, ");
+  Serial.print(telemetryStore.getBacklogCount());
+  Serial.println(" left");
 }
 
 // ==================== Publish LED Status ====================
@@ -322,35 +511,124 @@ void publishLEDStatus() {
     return;
   }
 
-  LEDMode mode = ledController.getMode();
-  String modeStr;
-
-  switch (mode) {
-  case MODE_OFF:
-    modeStr = "off";
-    break;
-  case MODE_SKY_SIMULATION:
-    modeStr = "sky_simulation";
-    break;
-  case MODE_RAIN:
-    modeStr = "rain";
-    break;
-  case MODE_METEOR:
-    modeStr = "meteor";
-    break;
-  case MODE_APOCALYPSE:
-    modeStr = "apocalypse";
-    break;
-  case MODE_BASIC:
-    modeStr = "basic";
-    break;
-  default:
-    modeStr = "unknown";
-  }
+  String modeStr = getEffectInfo(ledController.getMode()).name;
 
   mqttHandler.publishLEDStatus(modeStr, lastBrightness, 255, 255, 255);
 }
 
+// ==================== Log Diagnostics ====================
+void logStats() {
+  LEDFrameStats frameStats = ledController.getFrameStats();
+  Serial.print("[LED] Frames rendered: ");
+  Serial.print(frameStats.rendered);
+  Serial.print(" late: ");
+  Serial.print(frameStats.late);
+  Serial.print(" dropped: ");
+  Serial.print(frameStats.dropped);
+  Serial.print(" shown: ");
+  Serial.print(frameStats.shown);
+  Serial.print(" skipped: ");
+  Serial.print(frameStats.skipped);
+  Serial.print(" layer flatten max: ");
+  Serial.print(frameStats.flattenMaxUs);
+  Serial.println(" us");
+
+  LEDPipelineStats pipelineStats = ledController.getPipelineStats();
+  Serial.print("[LED] Output frames shown: ");
+  Serial.print(pipelineStats.shown);
+  Serial.print(" overwritten: ");
+  Serial.print(pipelineStats.overwritten);
+  Serial.print(" dither refreshes: ");
+  Serial.println(pipelineStats.refreshed);
+
+  SensorTaskStats sensorStats = sensorTask.getStats();
+  Serial.print("[Sensor] Task cycles: ");
+  Serial.print(sensorStats.cycles);
+  Serial.print(" snapshots: ");
+  Serial.print(sensorStats.samples);
+  Serial.print(" dropped: ");
+  Serial.print(sensorStats.dropped);
+  Serial.print(" late max: ");
+  Serial.print(sensorStats.lateMaxUs);
+  Serial.print(" us busy max: ");
+  Serial.print(sensorStats.busyMaxUs);
+  Serial.println(" us");
+
+  PublishPolicyStats publishStats = publishPolicy.getStats();
+  Serial.print("[Data] Published: ");
+  Serial.print(publishStats.sent);
+  Serial.print(" (state ");
+  Serial.print(publishStats.byState);
+  Serial.print(", delta ");
+  Serial.print(publishStats.byDelta);
+  Serial.print(", heartbeat ");
+  Serial.print(publishStats.byHeartbeat);
+  Serial.print(") suppressed: ");
+  Serial.print(publishStats.suppressed);
+  Serial.print(" failed: ");
+  Serial.println(publishStats.failed);
+
+  if (telemetryBatch.isEnabled() || telemetryBatch.getCount() > 0) {
+    TelemetryBatchStats batchStats = telemetryBatch.getStats();
+    Serial.print("[Data] Batches sent: ");
+    Serial.print(batchStats.messages);
+    Serial.print(" records: ");
+    Serial.print(batchStats.records);
+    Serial.print(" queued: ");
+    Serial.print(telemetryBatch.getCount());
+    Serial.print(" dropped: ");
+    Serial.println(batchStats.dropped);
+  }
+
+  if (telemetryStore.hasBacklog() || telemetryStore.getStats().stored > 0) {
+    TelemetryStoreStats storeStats = telemetryStore.getStats();
+    Serial.print("[Store] Backlog: ");
+    Serial.print(telemetryStore.getRamCount());
+    Serial.print(" in RAM, ");
+    Serial.print(telemetryStore.getLogCount());
+    Serial.print(" in ");
+    Serial.print(telemetryStore.getSegmentCount());
+    Serial.print(" segments; stored: ");
+    Serial.print(storeStats.stored);
+    Serial.print(" replayed: ");
+    Serial.print(storeStats.replayed);
+    Serial.print(" dropped: ");
+    Serial.println(storeStats.dropped);
+  }
+
+  MQTTConnectionStats mqttStats = mqttHandler.getStats();
+  Serial.print("[MQTT] State: ");
+  Serial.print(MQTTHandler::getStateName(mqttHandler.getState()));
+  Serial.print(", attempts: ");
+  Serial.print(mqttStats.attempts);
+  Serial.print(" failed: ");
+  Serial.print(mqttStats.failures);
+  Serial.print(", connect time last: ");
+  Serial.print(mqttStats.lastAttemptMs);
+  Serial.print(" ms max: ");
+  Serial.print(mqttStats.maxAttemptMs);
+  Serial.print(" ms total: ");
+  Serial.print(mqttStats.connectingMs);
+  Serial.print(" ms");
+  if (mqttStats.retryInMs > 0) {
+    Serial.print(", retry in ");
+    Serial.print(mqttStats.retryInMs);
+    Serial.print(" ms");
+  }
+  Serial.println();
+
+  Serial.print("[Loop] Busy max: ");
+  Serial.print(loopMaxUs);
+  Serial.print(" us avg: ");
+  Serial.print(loopCount ? loopTotalUs / loopCount : 0);
+  Serial.print(" us over ");
+  Serial.print(loopCount);
+  Serial.println(" loops");
+  loopMaxUs = 0;
+  loopTotalUs = 0;
+  loopCount = 0;
+}
+
 // ==================== MQTT Callback ====================
 void mqttCallback(char *topic, uint8_t *payload, unsigned int length) {
   Serial.print("[MQTT] Message received on topic: ");
@@ -364,8 +642,8 @@ void mqttCallback(char *topic, uint8_t *payload, unsigned int length) {
   Serial.print("[MQTT] Payload: ");
   Serial.println(message);
 
-  // Parse JSON
-  StaticJsonDocument<256> doc;
+  // Parse JSON (sized for a full segment layout)
+  StaticJsonDocument<512> doc;
   DeserializationError error = deserializeJson(doc, message);
 
   if (error) {
@@ -382,10 +660,20 @@ void mqttCallback(char *topic, uint8_t *payload, unsigned int length) {
   else if (strcmp(topic, MQTT_TOPIC_RADAR_CONTROL) == 0) {
     handleRadarControl(doc);
   }
+  // Handle sensor settings
+  else if (strcmp(topic, MQTT_TOPIC_SENSOR_CONTROL) == 0) {
+    handleSensorControl(doc);
+  }
 }
 
 // ==================== Handle LED Control ====================
 void handleLEDControl(JsonDocument &doc) {
+  // Optional crossfade duration (ms) for mode changes in this command
+  uint16_t transitionMs = LED_TRANSITION_MS;
+  if (doc.containsKey("transition_ms")) {
+    transitionMs = doc["transition_ms"].as<uint16_t>();
+  }
+
   // Handle presence_mode_enabled (radar auto mode)
   if (doc.containsKey("presence_mode_enabled")) {
     bool presenceModeEnabled = doc["presence_mode_enabled"].as<bool>();
@@ -408,10 +696,10 @@ void handleLEDControl(JsonDocument &doc) {
       // Only apply manual control if not in presence mode
       if (ledIsOn) {
         if (ledController.getMode() == MODE_OFF) {
-          ledController.setMode(MODE_BASIC);
+          ledController.setMode(MODE_BASIC, transitionMs);
         }
       } else {
-        ledController.setMode(MODE_OFF);
+        ledController.setMode(MODE_OFF, transitionMs);
       }
       Serial.println("[Control] LED manually turned " + String(ledIsOn ? "ON" : "OFF"));
     }
@@ -421,21 +709,13 @@ void handleLEDControl(JsonDocument &doc) {
   if (doc.containsKey("led_mode")) {
     String mode = doc["led_mode"].as<String>();
 
-    if (mode == "off") {
-      ledController.setMode(MODE_OFF);
-    } else if (mode == "sky_simulation") {
-      ledController.setMode(MODE_SKY_SIMULATION);
-    } else if (mode == "rain") {
-      ledController.setMode(MODE_RAIN);
-    } else if (mode == "meteor") {
-      ledController.setMode(MODE_METEOR);
-    } else if (mode == "apocalypse") {
-      ledController.setMode(MODE_APOCALYPSE);
-    } else if (mode == "basic") {
-      ledController.setMode(MODE_BASIC);
+    const EffectInfo *effect = findEffectByName(mode.c_str());
+    if (effect == nullptr) {
+      Serial.println("[Control] Unknown LED mode: " + mode);
+    } else {
+      ledController.setMode(effect->mode, transitionMs);
+      Serial.println("[Control] LED mode changed to: " + mode);
     }
-
-    Serial.println("[Control] LED mode changed to: " + mode);
   }
 
   // Handle brightness change
@@ -464,11 +744,110 @@ void handleLEDControl(JsonDocument &doc) {
     Serial.println(")");
   }
 
+  // Handle overlay layer change
+  if (doc.containsKey("layer")) {
+    handleLEDLayer(doc["layer"]);
+  }
+
+  // Handle strip layout change (stored, applied at the next boot)
+  if (doc.containsKey("layout")) {
+    handleLEDLayout(doc["layout"]);
+  }
+
   // Publish updated status
   publishLEDStatus();
   publishRadarStatus();
 }
 
+// ==================== Handle LED Layer ====================
+void handleLEDLayer(JsonObject layerJson) {
+  uint8_t index = layerJson["index"] | 0;
+  const char *mode = layerJson["mode"] | "none";
+
+  if (strcmp(mode, "none") == 0) {
+    ledController.clearLayer(index);
+    return;
+  }
+
+  const EffectInfo *effect = findEffectByName(mode);
+  if (effect == nullptr) {
+    Serial.println("[Control] Unknown LED mode for layer: " + String(mode));
+    return;
+  }
+  LEDBlendMode blend = BLEND_ADD;
+  const char *blendName = layerJson["blend"];
+  if (blendName != nullptr && !findBlendModeByName(blendName, blend)) {
+    Serial.println("[Control] Unknown blend mode: " + String(blendName));
+    return;
+  }
+  uint8_t opacity = layerJson["opacity"] | 255;
+
+  if (!ledController.setLayer(index, effect->mode, blend, opacity)) {
+    Serial.println("[Control] Invalid LED layer index: " + String(index));
+  }
+}
+
+// ==================== Handle LED Layout ====================
+// Reads a layout count/index as long and range-checks it before it is
+// narrowed into a uint16_t field (negative or huge values would wrap)
+bool readLayoutValue(JsonVariant value, long fallback, long minValue, const char *name, uint16_t &out) {
+  long raw = value | fallback;
+  if (raw < minValue || raw > LED_MAX_LEDS) {
+    Serial.println("[Control] LED layout " + String(name) + " out of range (" + String(minValue) +
+                   "-" + String(LED_MAX_LEDS) + "): " + String(raw));
+    return false;
+  }
+  out = (uint16_t)raw;
+  return true;
+}
+
+void handleLEDLayout(JsonObject layoutJson) {
+  LEDLayout layout;
+  memset(&layout, 0, sizeof(layout));
+  if (!readLayoutValue(layoutJson["num_leds"], NUM_LEDS, 1, "num_leds", layout.numLeds)) {
+    return;
+  }
+
+  JsonArray segments = layoutJson["segments"];
+  if (segments.isNull() || segments.size() == 0) {
+    // No segments given - one segment over the whole strip
+    layout.segmentCount = 1;
+    layout.segments[0].length = layout.numLeds;
+    layout.segments[0].mode = SEGMENT_FOLLOW_MODE;
+  } else {
+    for (JsonObject segmentJson : segments) {
+      if (layout.segmentCount >= LED_MAX_SEGMENTS) {
+        Serial.println("[Control] Too many LED segments (max " + String(LED_MAX_SEGMENTS) + ")");
+        return;
+      }
+      LEDSegment &segment = layout.segments[layout.segmentCount++];
+      if (!readLayoutValue(segmentJson["start"], 0, 0, "start", segment.start) ||
+          !readLayoutValue(segmentJson["length"], 0, 1, "length", segment.length)) {
+        return;
+      }
+      segment.reversed = segmentJson["reverse"] | false;
+      segment.mode = SEGMENT_FOLLOW_MODE;
+
+      const char *mode = segmentJson["mode"];
+      if (mode != nullptr && strcmp(mode, "follow") != 0) {
+        const EffectInfo *effect = findEffectByName(mode);
+        if (effect == nullptr) {
+          Serial.println("[Control] Unknown LED mode in layout: " + String(mode));
+          return;
+        }
+        segment.mode = effect->mode;
+      }
+    }
+  }
+
+  if (!saveLEDLayout(layout)) {
+    Serial.println("[Control] Invalid LED layout - not saved");
+    return;
+  }
+  Serial.println("[Control] LED layout saved (" + String(layout.numLeds) + " LEDs, " +
+                 String(layout.segmentCount) + " segment(s)) - restart to apply");
+}
+
 // ==================== Handle Radar Control ====================
 void handleRadarControl(JsonDocument &doc) {
   // Handle radar enable/disable
@@ -477,7 +856,7 @@ void handleRadarControl(JsonDocument &doc) {
 
     if (!radarEnabled) {
       // When radar is disabled, turn off LED
-      ledController.setMode(MODE_OFF);
+      ledController.setMode(MODE_OFF, LED_TRANSITION_MS);
       radarAutoMode = false;
       Serial.println("[Radar] Radar disabled - LED turned OFF");
     } else {
@@ -491,6 +870,59 @@ void handleRadarControl(JsonDocument &doc) {
   publishRadarStatus();
 }
 
+// ==================== Handle Sensor Control ====================
+void handleSensorControl(JsonDocument &doc) {
+  // Turbidity moving average length, in blocks of TURBIDITY_BLOCK_MS
+  if (doc.containsKey("turbidity_window")) {
+    sensorTask.setTurbidityWindow(doc["turbidity_window"].as<uint16_t>());
+  }
+
+  // Telemetry publishing policy
+  PublishPolicyConfig policy = publishPolicy.getConfig();
+  bool policyChanged = false;
+  if (doc.containsKey("deadband_temperature")) {
+    policy.deadband[TELEMETRY_TEMPERATURE] = doc["deadband_temperature"].as<float>();
+    policyChanged = true;
+  }
+  if (doc.containsKey("deadband_turbidity")) {
+    policy.deadband[TELEMETRY_TURBIDITY] = doc["deadband_turbidity"].as<float>();
+    policyChanged = true;
+  }
+  if (doc.containsKey("deadband_ph")) {
+    policy.deadband[TELEMETRY_PH] = doc["deadband_ph"].as<float>();
+    policyChanged = true;
+  }
+  if (doc.containsKey("publish_min_interval_ms")) {
+    policy.minIntervalMs = doc["publish_min_interval_ms"].as<uint32_t>();
+    policyChanged = true;
+  }
+  if (doc.containsKey("publish_heartbeat_ms")) {
+    policy.heartbeatMs = doc["publish_heartbeat_ms"].as<uint32_t>();
+    policyChanged = true;
+  }
+  if (policyChanged) {
+    publishPolicy.setConfig(policy);
+    policy = publishPolicy.getConfig();
+    Serial.println("[Control] Publish policy: deadbands " +
+                   String(policy.deadband[TELEMETRY_TEMPERATURE], 2) + " C, " +
+                   String(policy.deadband[TELEMETRY_TURBIDITY], 2) + " NTU, " +
+                   String(policy.deadband[TELEMETRY_PH], 2) + " pH; every " +
+                   String(policy.minIntervalMs) + "-" + String(policy.heartbeatMs) + " ms");
+  }
+
+  // Batched telemetry; batch_size 0 sends every record on its own again
+  if (doc.containsKey("batch_size") || doc.containsKey("batch_max_latency_ms")) {
+    uint16_t batchSize = doc.containsKey("batch_size") ? doc["batch_size"].as<uint16_t>()
+                                                       : telemetryBatch.getSize();
+    uint32_t batchLatency = doc.containsKey("batch_max_latency_ms")
+                                ? doc["batch_max_latency_ms"].as<uint32_t>()
+                                : telemetryBatch.getMaxLatency();
+    telemetryBatch.setConfig(batchSize, batchLatency);
+    Serial.println("[Control] Telemetry batch: " + String(telemetryBatch.getSize()) +
+                   " records, at most " + String(telemetryBatch.getMaxLatency()) + " ms");
+  }
+}
+
 // ==================== Check Radar and Control LED ====================
 void checkRadarAndControlLED() {
   if (!radarEnabled || !radarAutoMode) {
@@ -510,7 +942,8 @@ void checkRadarAndControlLED() {
   if (presenceDetected && distance > 0 && distance <= 2000) {
     // Human detected within 20m - turn LED ON
     if (ledController.getMode() == MODE_OFF) {
-      ledController.setMode(MODE_BASIC);
+      // Fade in instead of snapping on
+      ledController.setMode(MODE_BASIC, LED_TRANSITION_MS);
       ledController.setCustomColor(255, 255, 255); // White
       ledController.setBrightness(200);
       Serial.print("[Radar] Human detected at ");
@@ -521,7 +954,7 @@ void checkRadarAndControlLED() {
   } else {
     // No human detected or beyond 20m - turn LED OFF
     if (ledController.getMode() != MODE_OFF) {
-      ledController.setMode(MODE_OFF);
+      ledController.setMode(MODE_OFF, LED_TRANSITION_MS);
       Serial.println("[Radar] No human detected - LED OFF");
       publishRadarStatus();
     }
@@ -601,7 +1034,7 @@ void setupOLED() {
 }
 
 // ==================== Update OLED Display ====================
-void updateDisplay() {
+void updateDisplay(const SensorSnapshot& snapshot) {
   display.clearDisplay();
   display.setTextSize(1);
   display.setTextColor(SSD1306_WHITE);
@@ -609,8 +1042,8 @@ void updateDisplay() {
   // Line 1: Temperature
   display.setCursor(0, 0);
   display.print(F("Temp: "));
-  if (currentTemperature != DEVICE_DISCONNECTED_C) {
-    display.print(currentTemperature, 1);
+  if (snapshot.temperatures[0].valid) {
+    display.print(snapshot.temperatures[0].celsius, 1);
     display.print(F("C"));
   } else {
     display.print(F("ERR"));
@@ -619,8 +1052,8 @@ void updateDisplay() {
   // Line 2: Turbidity
   display.setCursor(0, 12);
   display.print(F("Turb: "));
-  if (currentTurbidity >= 0) {
-    display.print(currentTurbidity, 1);
+  if (snapshot.turbidity.valid && snapshot.turbidity.ntu >= 0) {
+    display.print(snapshot.turbidity.ntu, 1);
     display.print(F(" NTU"));
   } else {
     display.print(F("ERR"));
@@ -629,34 +1062,12 @@ void updateDisplay() {
   // Line 3: pH
   display.setCursor(0, 24);
   display.print(F("pH: "));
-  display.print(currentPH, 2);
+  display.print(snapshot.ph, 2);
 
   // Line 4: LED Mode
   display.setCursor(0, 36);
   display.print(F("LED: "));
-  LEDMode mode = ledController.getMode();
-  switch (mode) {
-  case MODE_OFF:
-    display.print(F("OFF"));
-    break;
-  case MODE_SKY_SIMULATION:
-    display.print(F("SKY"));
-    break;
-  case MODE_RAIN:
-    display.print(F("RAIN"));
-    break;
-  case MODE_METEOR:
-    display.print(F("METEOR"));
-    break;
-  case MODE_APOCALYPSE:
-    display.print(F("APOCALYPSE"));
-    break;
-  case MODE_BASIC:
-    display.print(F("BASIC"));
-    break;
-  default:
-    display.print(F("UNKNOWN"));
-  }
+  display.print(getEffectInfo(ledController.getMode()).label);
 
   // Line 5: Radar Mode
   display.setCursor(0, 48);
@@ -40,9 +40,16 @@ emyPxgcYxn/eR44/KJ4EBs+lVDR3veyJm+kXQ99b21/+jh5Xos1AnX5iItreGCc=
 -----END CERTIFICATE-----
 )EOF";
 
-MQTTHandler::MQTTHandler() {
+MQTTHandler::MQTTHandler() : attemptDone(false), attemptConnected(false) {
     mqttClient = nullptr;
-    lastReconnectAttempt = 0;
+    state = MQTT_STATE_WAITING;
+    nextAttemptMs = 0;
+    attemptStartMs = 0;
+    consecutiveFailures = 0;
+    memset(&stats, 0, sizeof(stats));
+#ifdef ESP32
+    connectTask = nullptr;
+#endif
 }
 
 bool MQTTHandler::init() {
@@ -52,7 +59,19 @@ bool MQTTHandler::init() {
     // Create MQTT client
     mqttClient = new PubSubClient(wifiClient);
     mqttClient->setServer(MQTT_SERVER, MQTT_PORT);
-    mqttClient->setBufferSize(512);  // Increase buffer for larger messages
+    mqttClient->setBufferSize(4096);  // Fits a full TELEMETRY_BATCH_CAPACITY batch
+    mqttClient->setSocketTimeout(MQTT_CONNECT_TIMEOUT_S);
+    
+#ifdef ESP32
+    // mbedTLS needs a deep stack for the handshake
+    BaseType_t result = xTaskCreatePinnedToCore(connectTaskEntry, "mqtt_connect", 8192, this,
+                                                tskIDLE_PRIORITY + 1, &connectTask,
+                                                MQTT_CONNECT_TASK_CORE);
+    if (result != pdPASS) {
+        connectTask = nullptr;
+        Serial.println("[MQTT] ERROR: Failed to start connect task - connecting from loop()");
+    }
+#endif
     
     Serial.println("[MQTT] Handler initialized");
     Serial.println("[MQTT] Server: " + String(MQTT_SERVER));
@@ -64,67 +83,181 @@ bool MQTTHandler::init() {
 void MQTTHandler::setupTLS() {
     // Set CA certificate for SSL/TLS
     wifiClient.setCACert(root_ca);
+    wifiClient.setHandshakeTimeout(MQTT_CONNECT_TIMEOUT_S);
     
     Serial.println("[MQTT] TLS/SSL configured");
 }
 
 bool MQTTHandler::connect() {
-    if (mqttClient->connected()) {
-        return true;
-    }
-    
-    Serial.print("[MQTT] Connecting to broker...");
-    
-    // Attempt to connect
-    if (mqttClient->connect(MQTT_CLIENT_ID, MQTT_USER, MQTT_PASSWORD)) {
-        Serial.println(" Connected!");
-        
-        // Subscribe to control topics
-        subscribeToTopics();
-        
-        // Publish online status
-        publishStatus("online");
-        
-        return true;
-    } else {
-        Serial.print(" Failed, rc=");
-        Serial.println(mqttClient->state());
+    if (!mqttClient) {
         return false;
     }
+    if (state == MQTT_STATE_WAITING) {
+        nextAttemptMs = millis();   // loop() starts it right away
+    }
+    return state == MQTT_STATE_CONNECTED;
 }
 
 void MQTTHandler::disconnect() {
-    if (mqttClient->connected()) {
+    if (state == MQTT_STATE_CONNECTED) {
         publishStatus("offline");
         mqttClient->disconnect();
         Serial.println("[MQTT] Disconnected");
+        consecutiveFailures = 0;
+        scheduleRetry(millis());
     }
 }
 
 bool MQTTHandler::isConnected() {
-    return mqttClient && mqttClient->connected();
+    // The state, not the socket: the connect task may be using the client
+    return state == MQTT_STATE_CONNECTED;
 }
 
 void MQTTHandler::loop() {
     if (!mqttClient) {
         return;
     }
+    unsigned long now = millis();
     
-    if (!mqttClient->connected()) {
-        unsigned long now = millis();
-        if (now - lastReconnectAttempt > RECONNECT_INTERVAL) {
-            lastReconnectAttempt = now;
-            if (connect()) {
-                lastReconnectAttempt = 0;
+    switch (state) {
+        case MQTT_STATE_CONNECTED:
+            if (mqttClient->connected()) {
+                mqttClient->loop();
+            } else {
+                Serial.print("[MQTT] Connection lost, rc=");
+                Serial.println(mqttClient->state());
+                consecutiveFailures = 0;
+                scheduleRetry(now);
+            }
+            break;
+            
+        case MQTT_STATE_WAITING:
+            // No point in a handshake without WiFi; try as soon as it is back
+            if ((long)(now - nextAttemptMs) >= 0 && WiFi.status() == WL_CONNECTED) {
+                startAttempt(now);
+            }
+            break;
+            
+        case MQTT_STATE_CONNECTING:
+            if (attemptDone.load(std::memory_order_acquire)) {
+                attemptDone.store(false, std::memory_order_relaxed);
+                finishAttempt(attemptConnected.load(std::memory_order_relaxed), millis());
             }
+            break;
+    }
+}
+
+void MQTTHandler::startAttempt(unsigned long now) {
+    state = MQTT_STATE_CONNECTING;
+    attemptStartMs = now;
+    stats.attempts++;
+    Serial.println("[MQTT] Connecting to broker...");
+    
+#ifdef ESP32
+    if (connectTask != nullptr) {
+        xTaskNotifyGive(connectTask);
+        return;
+    }
+#endif
+    // No connect task (host build): the attempt runs here
+    bool connected = mqttClient->connect(MQTT_CLIENT_ID, MQTT_USER, MQTT_PASSWORD);
+    finishAttempt(connected, millis());
+}
+
+#ifdef ESP32
+void MQTTHandler::connectTaskEntry(void* arg) {
+    MQTTHandler* handler = (MQTTHandler*)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        // loop() leaves the client alone until attemptDone is set
+        bool connected = handler->mqttClient->connect(MQTT_CLIENT_ID, MQTT_USER, MQTT_PASSWORD);
+        handler->attemptConnected.store(connected, std::memory_order_relaxed);
+        handler->attemptDone.store(true, std::memory_order_release);
+    }
+}
+#endif
+
+void MQTTHandler::finishAttempt(bool connected, unsigned long now) {
+    uint32_t duration = now - attemptStartMs;
+    stats.lastAttemptMs = duration;
+    stats.connectingMs += duration;
+    if (duration > stats.maxAttemptMs) {
+        stats.maxAttemptMs = duration;
+    }
+    
+    if (!connected) {
+        stats.failures++;
+        if (consecutiveFailures < 31) {
+            consecutiveFailures++;
         }
-    } else {
-        mqttClient->loop();
+        Serial.print("[MQTT] Connect failed after ");
+        Serial.print(duration);
+        Serial.print(" ms, rc=");
+        Serial.println(mqttClient->state());
+        scheduleRetry(now);
+        return;
     }
+    
+    state = MQTT_STATE_CONNECTED;
+    consecutiveFailures = 0;
+    Serial.print("[MQTT] Connected in ");
+    Serial.print(duration);
+    Serial.println(" ms");
+    
+    // Subscribe to control topics
+    subscribeToTopics();
+    
+    // Publish online status
+    publishStatus("online");
+}
+
+// Equal jitter: half the exponential delay fixed, the other half random
+void MQTTHandler::scheduleRetry(unsigned long now) {
+    uint32_t backoff = MQTT_BACKOFF_MIN_MS;
+    for (uint8_t i = 1; i < consecutiveFailures && backoff < MQTT_BACKOFF_MAX_MS; i++) {
+        backoff *= 2;
+    }
+    if (backoff > MQTT_BACKOFF_MAX_MS) {
+        backoff = MQTT_BACKOFF_MAX_MS;
+    }
+    uint32_t delayMs = backoff / 2 + random(backoff / 2 + 1);
+    
+    state = MQTT_STATE_WAITING;
+    nextAttemptMs = now + delayMs;
+    if (consecutiveFailures > 0) {
+        Serial.print("[MQTT] Retrying in ");
+        Serial.print(delayMs);
+        Serial.println(" ms");
+    }
+}
+
+MQTTConnectionState MQTTHandler::getState() {
+    return state;
+}
+
+const char* MQTTHandler::getStateName(MQTTConnectionState state) {
+    switch (state) {
+        case MQTT_STATE_WAITING:    return "waiting";
+        case MQTT_STATE_CONNECTING: return "connecting";
+        case MQTT_STATE_CONNECTED:  return "connected";
+        default:                    return "unknown";
+    }
+}
+
+MQTTConnectionStats MQTTHandler::getStats() {
+    MQTTConnectionStats current = stats;
+    current.retryInMs = 0;
+    if (state == MQTT_STATE_WAITING && (long)(nextAttemptMs - millis()) > 0) {
+        current.retryInMs = nextAttemptMs - millis();
+    }
+    if (state == MQTT_STATE_CONNECTING) {
+        current.connectingMs += millis() - attemptStartMs;
+    }
+    return current;
 }
 
 bool MQTTHandler::subscribeToTopics() {
-    if (!mqttClient || !mqttClient->connected()) {
+    if (!isConnected()) {
         return false;
     }
     
@@ -154,6 +287,14 @@ bool MQTTHandler::subscribeToTopics() {
         success = false;
     }
     
+    // Subscribe to sensor control topic
+    if (mqttClient->subscribe(MQTT_TOPIC_SENSOR_CONTROL)) {
+        Serial.println("[MQTT] Subscribed to: " + String(MQTT_TOPIC_SENSOR_CONTROL));
+    } else {
+        Serial.println("[MQTT] Failed to subscribe to: " + String(MQTT_TOPIC_SENSOR_CONTROL));
+        success = false;
+    }
+    
     return success;
 }
 
@@ -222,7 +363,7 @@ bool MQTTHandler::publishLEDStatus(String mode, uint8_t brightness, uint8_t r, u
 }
 
 bool MQTTHandler::publishStatus(String status) {
-    if (!mqttClient) {
+    if (!isConnected()) {
         return false;
     }
     
@@ -0,0 +1,121 @@
+/**
+ * @file publish_policy.cpp
+ * @brief Send-on-delta / heartbeat decision for sensor telemetry
+ */
+
+#include "publish_policy.h"
+
+PublishPolicy::PublishPolicy() {
+    config = defaultConfig();
+    stats = {0, 0, 0, 0, 0, 0};
+    hasSent = false;
+    memset(&reference, 0, sizeof(reference));
+}
+
+PublishPolicyConfig PublishPolicy::defaultConfig() {
+    PublishPolicyConfig defaults;
+    defaults.deadband[TELEMETRY_TEMPERATURE] = TELEMETRY_DEADBAND_TEMPERATURE;
+    defaults.deadband[TELEMETRY_TURBIDITY] = TELEMETRY_DEADBAND_TURBIDITY;
+    defaults.deadband[TELEMETRY_PH] = TELEMETRY_DEADBAND_PH;
+    defaults.minIntervalMs = TELEMETRY_MIN_INTERVAL_MS;
+    defaults.heartbeatMs = TELEMETRY_HEARTBEAT_MS;
+    return defaults;
+}
+
+void PublishPolicy::setConfig(const PublishPolicyConfig& newConfig) {
+    config = newConfig;
+    if (config.heartbeatMs < config.minIntervalMs) {
+        config.heartbeatMs = config.minIntervalMs;
+    }
+}
+
+PublishPolicyConfig PublishPolicy::getConfig() {
+    return config;
+}
+
+bool PublishPolicy::moved(float value, float last, TelemetryField field) {
+    float change = fabsf(value - last);
+    float deadband = config.deadband[field];
+    return deadband > 0 ? change >= deadband : change > 0;
+}
+
+bool PublishPolicy::stateChanged(const SensorSnapshot& snapshot) {
+    if (snapshot.temperatureCount != reference.temperatureCount ||
+        snapshot.turbidity.valid != reference.turbidity.valid ||
+        snapshot.turbidity.quality != reference.turbidity.quality) {
+        return true;
+    }
+    for (uint8_t i = 0; i < snapshot.temperatureCount; i++) {
+        if (snapshot.temperatures[i].valid != reference.temperatures[i].valid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+PublishReason PublishPolicy::evaluate(const SensorSnapshot& snapshot) {
+    if (!hasSent) {
+        return PUBLISH_FIRST;
+    }
+    
+    unsigned long silentMs = snapshot.timestampMs - reference.timestampMs;
+    PublishReason reason = PUBLISH_NONE;
+    
+    if (silentMs >= config.minIntervalMs) {
+        if (stateChanged(snapshot)) {
+            reason = PUBLISH_STATE;
+        } else {
+            bool delta = snapshot.turbidity.valid &&
+                         moved(snapshot.turbidity.ntu, reference.turbidity.ntu, TELEMETRY_TURBIDITY);
+            delta = delta || moved(snapshot.ph, reference.ph, TELEMETRY_PH);
+            for (uint8_t i = 0; i < snapshot.temperatureCount && !delta; i++) {
+                delta = snapshot.temperatures[i].valid &&
+                        moved(snapshot.temperatures[i].celsius, reference.temperatures[i].celsius,
+                              TELEMETRY_TEMPERATURE);
+            }
+            if (delta) {
+                reason = PUBLISH_DELTA;
+            } else if (silentMs >= config.heartbeatMs) {
+                reason = PUBLISH_HEARTBEAT;
+            }
+        }
+    }
+    
+    if (reason == PUBLISH_NONE) {
+        stats.suppressed++;
+    }
+    return reason;
+}
+
+void PublishPolicy::markSent(const SensorSnapshot& snapshot, PublishReason reason) {
+    reference = snapshot;
+    hasSent = true;
+    stats.sent++;
+    if (reason == PUBLISH_STATE) {
+        stats.byState++;
+    } else if (reason == PUBLISH_DELTA) {
+        stats.byDelta++;
+    } else if (reason == PUBLISH_HEARTBEAT) {
+        stats.byHeartbeat++;
+    }
+}
+
+void PublishPolicy::markStored(const SensorSnapshot& snapshot) {
+    reference = snapshot;
+    hasSent = true;
+    stats.failed++;
+}
+
+PublishPolicyStats PublishPolicy::getStats() {
+    return stats;
+}
+
+const char* PublishPolicy::getReasonName(PublishReason reason) {
+    switch (reason) {
+        case PUBLISH_FIRST:     return "first";
+        case PUBLISH_STATE:     return "state";
+        case PUBLISH_DELTA:     return "delta";
+        case PUBLISH_HEARTBEAT: return "heartbeat";
+        default:                return "none";
+    }
+}
@@ -0,0 +1,196 @@
+/**
+ * @file telemetry_batch.cpp
+ * @brief Columnar multi-record sensor messages with delta-encoded timestamps
+ */
+
+#include "telemetry_batch.h"
+#include <math.h>
+#include <string.h>
+
+// Per-record columns besides the per-probe temperatures: dt, samples,
+// temperature(_min/_max), turbidity(_min/_max), ph(_min/_max), water_quality
+#define BATCH_RECORD_COLUMNS 12
+#define BATCH_ROOT_MEMBERS 17   // Columns + t0, n, temperatures, boot, replay
+
+static float meanOrNan(const MetricSummary& metric) {
+    return metric.count > 0 ? metric.mean : NAN;
+}
+
+TelemetryRecord makeTelemetryRecord(const SensorSnapshot& snapshot, const TelemetrySummary& summary) {
+    TelemetryRecord record;
+    memset(&record, 0, sizeof(record));
+    record.timestampMs = snapshot.timestampMs;
+    record.samples = summary.snapshots > 0xFFFF ? 0xFFFF : summary.snapshots;
+    record.temperatureCount = summary.temperatureCount;
+    record.quality = snapshot.turbidity.quality;
+    
+    for (uint8_t i = 0; i < DS18B20_MAX_PROBES; i++) {
+        record.temperature[i] = i < summary.temperatureCount ? meanOrNan(summary.temperatures[i]) : NAN;
+    }
+    const MetricSummary& temperature = summary.temperatures[0];
+    record.temperatureMin = temperature.count > 0 ? temperature.min : NAN;
+    record.temperatureMax = temperature.count > 0 ? temperature.max : NAN;
+    
+    record.turbidity = meanOrNan(summary.turbidity);
+    record.turbidityMin = summary.turbidity.count > 0 ? summary.turbidity.min : NAN;
+    record.turbidityMax = summary.turbidity.count > 0 ? summary.turbidity.max : NAN;
+    
+    record.ph = meanOrNan(summary.ph);
+    record.phMin = summary.ph.count > 0 ? summary.ph.min : NAN;
+    record.phMax = summary.ph.count > 0 ? summary.ph.max : NAN;
+    return record;
+}
+
+// Two decimals is below every sensor's resolution and keeps numbers short
+static void addValue(JsonArray column, float value) {
+    if (isnan(value)) {
+        column.add(nullptr);
+    } else {
+        column.add(roundf(value * 100.0f) / 100.0f);
+    }
+}
+
+TelemetryBatch::TelemetryBatch() {
+    count = 0;
+    memset(&stats, 0, sizeof(stats));
+    setConfig(TELEMETRY_BATCH_SIZE, TELEMETRY_BATCH_MAX_LATENCY_MS);
+}
+
+void TelemetryBatch::setConfig(uint16_t batchSize, uint32_t latencyMs) {
+    if (batchSize > TELEMETRY_BATCH_CAPACITY) {
+        batchSize = TELEMETRY_BATCH_CAPACITY;
+    }
+    size = batchSize;
+    maxLatencyMs = latencyMs;
+}
+
+uint16_t TelemetryBatch::getSize() {
+    return size;
+}
+
+uint32_t TelemetryBatch::getMaxLatency() {
+    return maxLatencyMs;
+}
+
+bool TelemetryBatch::isEnabled() {
+    return size > 1;
+}
+
+void TelemetryBatch::add(const TelemetryRecord& record) {
+    if (count == TELEMETRY_BATCH_CAPACITY) {
+        memmove(&records[0], &records[1], sizeof(TelemetryRecord) * (count - 1));
+        count--;
+        stats.dropped++;
+    }
+    records[count++] = record;
+}
+
+bool TelemetryBatch::isDue(unsigned long now) {
+    if (count == 0) {
+        return false;
+    }
+    if (!isEnabled() || count >= size) {
+        return true;
+    }
+    return (uint32_t)(now - records[0].timestampMs) >= maxLatencyMs;
+}
+
+uint16_t TelemetryBatch::getCount() {
+    return count;
+}
+
+const TelemetryRecord* TelemetryBatch::getRecords() {
+    return records;
+}
+
+void TelemetryBatch::toJson(JsonDocument& doc) {
+    toJson(doc, records, count);
+}
+
+size_t TelemetryBatch::jsonCapacity() {
+    return jsonCapacity(records, count);
+}
+
+void TelemetryBatch::markSent() {
+    if (count > 0) {
+        stats.messages++;
+        stats.records += count;
+    }
+    count = 0;
+}
+
+void TelemetryBatch::clear() {
+    count = 0;
+}
+
+TelemetryBatchStats TelemetryBatch::getStats() {
+    return stats;
+}
+
+uint8_t TelemetryBatch::probeColumns(const TelemetryRecord* records, uint16_t count) {
+    uint8_t probes = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        if (records[i].temperatureCount > probes) {
+            probes = records[i].temperatureCount;
+        }
+    }
+    return probes;
+}
+
+size_t TelemetryBatch::jsonCapacity(const TelemetryRecord* records, uint16_t count) {
+    uint8_t probes = probeColumns(records, count);
+    return JSON_OBJECT_SIZE(BATCH_ROOT_MEMBERS) +
+           (BATCH_RECORD_COLUMNS + probes) * JSON_ARRAY_SIZE(count) +
+           JSON_ARRAY_SIZE(probes);
+}
+
+void TelemetryBatch::toJson(JsonDocument& doc, const TelemetryRecord* records, uint16_t count) {
+    if (count == 0) {
+        return;
+    }
+    
+    doc["t0"] = records[0].timestampMs;
+    doc["n"] = count;
+    JsonArray dt = doc.createNestedArray("dt");
+    JsonArray samples = doc.createNestedArray("samples");
+    JsonArray temperature = doc.createNestedArray("temperature");
+    JsonArray temperatureMin = doc.createNestedArray("temperature_min");
+    JsonArray temperatureMax = doc.createNestedArray("temperature_max");
+    JsonArray turbidity = doc.createNestedArray("turbidity");
+    JsonArray turbidityMin = doc.createNestedArray("turbidity_min");
+    JsonArray turbidityMax = doc.createNestedArray("turbidity_max");
+    JsonArray ph = doc.createNestedArray("ph");
+    JsonArray phMin = doc.createNestedArray("ph_min");
+    JsonArray phMax = doc.createNestedArray("ph_max");
+    JsonArray quality = doc.createNestedArray("water_quality");
+    
+    uint32_t previous = records[0].timestampMs;
+    for (uint16_t i = 0; i < count; i++) {
+        const TelemetryRecord& record = records[i];
+        dt.add(record.timestampMs - previous);
+        previous = record.timestampMs;
+        samples.add(record.samples);
+        addValue(temperature, record.temperature[0]);
+        addValue(temperatureMin, record.temperatureMin);
+        addValue(temperatureMax, record.temperatureMax);
+        addValue(turbidity, record.turbidity);
+        addValue(turbidityMin, record.turbidityMin);
+        addValue(turbidityMax, record.turbidityMax);
+        addValue(ph, record.ph);
+        addValue(phMin, record.phMin);
+        addValue(phMax, record.phMax);
+        quality.add(getWaterQualityName((WaterQuality)record.quality));
+    }
+    
+    // One column per probe slot, like "temperatures" in single messages
+    uint8_t probes = probeColumns(records, count);
+    if (probes > 1) {
+        JsonArray temperatures = doc.createNestedArray("temperatures");
+        for (uint8_t p = 0; p < probes; p++) {
+            JsonArray column = temperatures.createNestedArray();
+            for (uint16_t i = 0; i < count; i++) {
+                addValue(column, p < records[i].temperatureCount ? records[i].temperature[p] : NAN);
+            }
+        }
+    }
+}
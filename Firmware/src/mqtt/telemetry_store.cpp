@@ -0,0 +1,401 @@
+/**
+ * @file telemetry_store.cpp
+ * @brief RAM ring plus LittleFS segment log for records sent while offline
+ */
+
+#include "telemetry_store.h"
+#include <LittleFS.h>
+#include <Preferences.h>
+
+#define STORE_PREF_NAMESPACE "telemetry"
+#define STORE_PREF_BOOT "boot"
+#define STORE_PREF_SEGMENT "seg"
+#define STORE_PREF_POSITION "pos"
+#define STORE_DIR "/tlm"
+#define SEGMENT_MAGIC 0x534D4C54UL   // "TLMS"
+#define SEGMENT_VERSION 1
+
+struct SegmentHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;             // A layout change makes old segments unreadable
+    uint32_t boot;
+};
+
+static void segmentPath(uint32_t segment, char* path, size_t length) {
+    snprintf(path, length, STORE_DIR "/%08lu.seg", (unsigned long)segment);
+}
+
+static bool validHeader(const SegmentHeader& header) {
+    return header.magic == SEGMENT_MAGIC && header.version == SEGMENT_VERSION &&
+           header.recordSize == sizeof(TelemetryRecord);
+}
+
+TelemetryStore::TelemetryStore() {
+    ramHead = 0;
+    ramCount = 0;
+    ramSinceMs = 0;
+    logReady = false;
+    spillBlocked = false;
+    spillBlockedMs = 0;
+    boot = 0;
+    oldestSegment = 1;
+    nextSegment = 1;
+    readPosition = 0;
+    logRecords = 0;
+    appendRecords = 0;
+    appendOpen = false;
+    peekSource = SOURCE_NONE;
+    memset(&stats, 0, sizeof(stats));
+}
+
+bool TelemetryStore::begin() {
+    Preferences preferences;
+    preferences.begin(STORE_PREF_NAMESPACE, false);
+    boot = preferences.getUInt(STORE_PREF_BOOT, 0) + 1;
+    preferences.putUInt(STORE_PREF_BOOT, boot);
+    uint32_t cursorSegment = preferences.getUInt(STORE_PREF_SEGMENT, 0);
+    uint32_t cursorPosition = preferences.getUInt(STORE_PREF_POSITION, 0);
+    preferences.end();
+
+    logReady = LittleFS.begin(true);
+    if (!logReady) {
+        Serial.println("[Store] LittleFS mount failed - offline records kept in RAM only");
+        return false;
+    }
+    if (!LittleFS.exists(STORE_DIR)) {
+        LittleFS.mkdir(STORE_DIR);
+    }
+
+    scanSegments(cursorSegment, cursorPosition);
+    Serial.print("[Store] Boot ");
+    Serial.print(boot);
+    Serial.print(", log: ");
+    Serial.print(logRecords);
+    Serial.print(" records in ");
+    Serial.print(getSegmentCount());
+    Serial.println(" segments");
+    return true;
+}
+
+uint32_t TelemetryStore::getBoot() {
+    return boot;
+}
+
+void TelemetryStore::scanSegments(uint32_t cursorSegment, uint32_t cursorPosition) {
+    uint32_t first = 0;
+    uint32_t last = 0;
+
+    File dir = LittleFS.open(STORE_DIR);
+    File file = dir.openNextFile();
+    while (file) {
+        unsigned long segment = strtoul(file.name(), nullptr, 10);
+        bool isSegment = segment > 0 && strstr(file.name(), ".seg") != nullptr;
+        file.close();
+        if (isSegment) {
+            if (first == 0 || segment < first) first = segment;
+            if (segment > last) last = segment;
+        }
+        file = dir.openNextFile();
+    }
+    dir.close();
+
+    if (first == 0) {
+        return;
+    }
+    oldestSegment = first;
+    nextSegment = last + 1;
+
+    // Segments from a different firmware layout can't be replayed
+    for (uint32_t segment = first; segment <= last; segment++) {
+        uint32_t segmentBoot = 0;
+        uint32_t records = countRecords(segment, &segmentBoot);
+        char path[32];
+        segmentPath(segment, path, sizeof(path));
+        if (records == 0 && LittleFS.exists(path)) {
+            LittleFS.remove(path);
+            Serial.print("[Store] Removed unreadable segment ");
+            Serial.println(path);
+        }
+        logRecords += records;
+    }
+
+    // Skip what was confirmed before the reboot
+    uint32_t oldestBoot = 0;
+    uint32_t oldestRecords = countRecords(oldestSegment, &oldestBoot);
+    if (cursorSegment == oldestSegment && cursorPosition <= oldestRecords) {
+        readPosition = cursorPosition;
+        logRecords -= cursorPosition;
+    }
+    // Never append to a segment of an earlier boot
+    appendOpen = false;
+}
+
+uint32_t TelemetryStore::countRecords(uint32_t segment, uint32_t* segmentBoot) {
+    char path[32];
+    segmentPath(segment, path, sizeof(path));
+    File file = LittleFS.open(path, FILE_READ);
+    if (!file) {
+        return 0;
+    }
+    SegmentHeader header;
+    size_t size = file.size();
+    bool valid = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) && validHeader(header);
+    file.close();
+    if (!valid) {
+        return 0;
+    }
+    if (segmentBoot) {
+        *segmentBoot = header.boot;
+    }
+    return (size - sizeof(header)) / sizeof(TelemetryRecord);
+}
+
+void TelemetryStore::add(const TelemetryRecord& record) {
+    stats.stored++;
+    if (ramCount == TELEMETRY_RAM_RECORDS) {
+        flush();
+    }
+    if (ramCount == TELEMETRY_RAM_RECORDS) {
+        // No log (or it failed): the oldest record makes room
+        ramHead = (ramHead + 1) % TELEMETRY_RAM_RECORDS;
+        ramCount--;
+        stats.dropped++;
+    }
+    if (ramCount == 0) {
+        ramSinceMs = millis();
+    }
+    ram[(ramHead + ramCount) % TELEMETRY_RAM_RECORDS] = record;
+    ramCount++;
+}
+
+void TelemetryStore::service(unsigned long now) {
+    if (ramCount > 0 && logReady && now - ramSinceMs >= TELEMETRY_SPILL_MS) {
+        flush();
+    }
+}
+
+void TelemetryStore::flush() {
+    if (!logReady || ramCount == 0) {
+        return;
+    }
+    if (spillBlocked && millis() - spillBlockedMs < TELEMETRY_SPILL_MS) {
+        return;   // The last write failed; don't retry on every record
+    }
+    spillBlocked = false;
+
+    // The ring may wrap: at most two contiguous runs
+    while (ramCount > 0) {
+        uint16_t run = ramCount;
+        if (ramHead + run > TELEMETRY_RAM_RECORDS) {
+            run = TELEMETRY_RAM_RECORDS - ramHead;
+        }
+        uint16_t written = append(&ram[ramHead], run);
+        ramHead = (ramHead + written) % TELEMETRY_RAM_RECORDS;
+        ramCount -= written;
+        stats.spilled += written;
+        if (written < run) {
+            // Log full or failing - keep the rest in RAM for now
+            spillBlocked = true;
+            spillBlockedMs = millis();
+            break;
+        }
+    }
+    if (ramCount > 0) {
+        ramSinceMs = millis();
+    }
+}
+
+uint16_t TelemetryStore::append(const TelemetryRecord* records, uint16_t count) {
+    uint16_t total = 0;
+    char path[32];
+
+    while (total < count) {
+        if (!appendOpen && !startSegment()) {
+            break;
+        }
+        uint16_t chunk = count - total;
+        if (chunk > TELEMETRY_SEGMENT_RECORDS - appendRecords) {
+            chunk = TELEMETRY_SEGMENT_RECORDS - appendRecords;
+        }
+
+        segmentPath(nextSegment - 1, path, sizeof(path));
+        File file = LittleFS.open(path, FILE_APPEND);
+        size_t bytes = file ? file.write((const uint8_t*)&records[total], chunk * sizeof(TelemetryRecord)) : 0;
+        file.close();
+
+        uint16_t written = bytes / sizeof(TelemetryRecord);
+        appendRecords += written;
+        logRecords += written;
+        total += written;
+        if (written < chunk) {
+            // A partial record now ends the file; it is never appended to
+            // again. Filesystem full before the log bound: make room the
+            // same way, by giving up the oldest segment.
+            stats.writeErrors++;
+            appendOpen = false;
+            if (getSegmentCount() > 1) {
+                dropOldestSegment();
+                continue;
+            }
+            break;
+        }
+        if (appendRecords >= TELEMETRY_SEGMENT_RECORDS) {
+            appendOpen = false;
+        }
+    }
+    return total;
+}
+
+bool TelemetryStore::startSegment() {
+    if (getSegmentCount() >= TELEMETRY_LOG_MAX_SEGMENTS) {
+        dropOldestSegment();
+    }
+
+    char path[32];
+    segmentPath(nextSegment, path, sizeof(path));
+    SegmentHeader header = {SEGMENT_MAGIC, SEGMENT_VERSION, sizeof(TelemetryRecord), boot};
+    File file = LittleFS.open(path, FILE_WRITE, true);
+    bool written = file && file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header);
+    file.close();
+    if (!written) {
+        LittleFS.remove(path);
+        stats.writeErrors++;
+        return false;
+    }
+
+    if (getSegmentCount() == 0) {
+        oldestSegment = nextSegment;
+        readPosition = 0;
+    }
+    nextSegment++;
+    appendRecords = 0;
+    appendOpen = true;
+    return true;
+}
+
+void TelemetryStore::dropOldestSegment() {
+    uint32_t records = countRecords(oldestSegment, nullptr);
+    uint32_t lost = records > readPosition ? records - readPosition : 0;
+    stats.dropped += lost;
+    logRecords -= lost < logRecords ? lost : logRecords;
+    removeOldestSegment();
+
+    Serial.print("[Store] Log full - dropped ");
+    Serial.print(lost);
+    Serial.println(" oldest records");
+}
+
+void TelemetryStore::removeOldestSegment() {
+    char path[32];
+    segmentPath(oldestSegment, path, sizeof(path));
+    LittleFS.remove(path);
+
+    oldestSegment++;
+    readPosition = 0;
+    if (oldestSegment >= nextSegment) {
+        oldestSegment = nextSegment;
+        appendOpen = false;
+        logRecords = 0;
+    }
+    saveCursor();
+}
+
+void TelemetryStore::saveCursor() {
+    Preferences preferences;
+    preferences.begin(STORE_PREF_NAMESPACE, false);
+    preferences.putUInt(STORE_PREF_SEGMENT, oldestSegment);
+    preferences.putUInt(STORE_PREF_POSITION, readPosition);
+    preferences.end();
+}
+
+bool TelemetryStore::hasBacklog() {
+    return ramCount > 0 || logRecords > 0;
+}
+
+uint32_t TelemetryStore::getBacklogCount() {
+    return ramCount + logRecords;
+}
+
+uint16_t TelemetryStore::getRamCount() {
+    return ramCount;
+}
+
+uint32_t TelemetryStore::getLogCount() {
+    return logRecords;
+}
+
+uint32_t TelemetryStore::getSegmentCount() {
+    return nextSegment - oldestSegment;
+}
+
+uint16_t TelemetryStore::peek(TelemetryRecord* out, uint16_t max, uint32_t& recordBoot) {
+    peekSource = SOURCE_NONE;
+
+    // Everything in the log is older than anything in the ring
+    while (logReady && logRecords > 0 && getSegmentCount() > 0) {
+        char path[32];
+        segmentPath(oldestSegment, path, sizeof(path));
+        File file = LittleFS.open(path, FILE_READ);
+        SegmentHeader header;
+        bool valid = file && file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+                     validHeader(header);
+        uint32_t records = valid ? (file.size() - sizeof(header)) / sizeof(TelemetryRecord) : 0;
+        if (readPosition >= records) {
+            // Missing, unreadable or fully replayed
+            file.close();
+            removeOldestSegment();
+            continue;
+        }
+
+        uint32_t available = records - readPosition;
+        uint16_t count = available < max ? available : max;
+        file.seek(sizeof(header) + readPosition * sizeof(TelemetryRecord));
+        count = file.read((uint8_t*)out, count * sizeof(TelemetryRecord)) / sizeof(TelemetryRecord);
+        file.close();
+        if (count == 0) {
+            return 0;
+        }
+        recordBoot = header.boot;
+        peekSource = SOURCE_LOG;
+        return count;
+    }
+
+    if (ramCount == 0) {
+        return 0;
+    }
+    uint16_t count = ramCount < max ? ramCount : max;
+    for (uint16_t i = 0; i < count; i++) {
+        out[i] = ram[(ramHead + i) % TELEMETRY_RAM_RECORDS];
+    }
+    recordBoot = boot;
+    peekSource = SOURCE_RAM;
+    return count;
+}
+
+void TelemetryStore::consume(uint16_t count) {
+    if (peekSource == SOURCE_LOG) {
+        readPosition += count;
+        logRecords -= count < logRecords ? count : logRecords;
+        stats.replayed += count;
+
+        bool appending = appendOpen && oldestSegment == nextSegment - 1;
+        if (!appending && readPosition >= countRecords(oldestSegment, nullptr)) {
+            removeOldestSegment();
+        } else {
+            saveCursor();
+        }
+    } else if (peekSource == SOURCE_RAM) {
+        if (count > ramCount) {
+            count = ramCount;
+        }
+        ramHead = (ramHead + count) % TELEMETRY_RAM_RECORDS;
+        ramCount -= count;
+        stats.replayed += count;
+    }
+    peekSource = SOURCE_NONE;
+}
+
+TelemetryStoreStats TelemetryStore::getStats() {
+    return stats;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file adc_sampler.cpp
+ * @brief ADC sampling backends implementation
+ */
+
+#include "adc_sampler.h"
+
+#ifdef ESP32
+#include <driver/adc.h>
+
+// One conversion result in ADC_DIGI_OUTPUT_FORMAT_TYPE1 (12-bit data + channel)
+static const uint32_t RESULT_BYTES = sizeof(adc_digi_output_data_t);
+
+// ==================== Continuous (DMA) Sampler ====================
+bool ContinuousADCSampler::begin(uint8_t pin, uint32_t sampleRateHz) {
+    int8_t pinChannel = digitalPinToAnalogChannel(pin);
+    if (pinChannel < 0 || pinChannel >= 8) {
+        Serial.println("[ADC] ERROR: Pin " + String(pin) + " is not an ADC1 pin, continuous mode needs ADC1");
+        return false;
+    }
+    channel = pinChannel;
+
+    adc_digi_init_config_t initConfig = {};
+    initConfig.max_store_buf_size = DMA_BUFFER_BYTES;
+    initConfig.conv_num_each_intr = DMA_FRAME_BYTES;
+    initConfig.adc1_chan_mask = BIT(channel);
+    initConfig.adc2_chan_mask = 0;
+    if (adc_digi_initialize(&initConfig) != ESP_OK) {
+        Serial.println("[ADC] ERROR: Continuous mode initialization failed");
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern = {};
+    pattern.atten = ADC_ATTEN_DB_11;   // Full 0-3.3 V range
+    pattern.channel = channel;
+    pattern.unit = 0;                  // ADC1
+    pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+    adc_digi_configuration_t config = {};
+    config.conv_limit_en = true;       // Required on the ESP32
+    config.conv_limit_num = 250;
+    config.pattern_num = 1;
+    config.adc_pattern = &pattern;
+    config.sample_freq_hz = sampleRateHz;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+    if (adc_digi_controller_configure(&config) != ESP_OK || adc_digi_start() != ESP_OK) {
+        Serial.println("[ADC] ERROR: Continuous mode configuration failed");
+        adc_digi_deinitialize();
+        return false;
+    }
+
+    esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, 1100, &calibration);
+    running = true;
+
+    Serial.println("[ADC] Continuous sampling on pin " + String(pin) + " at " + String(sampleRateHz) + " Hz");
+    return true;
+}
+
+size_t ContinuousADCSampler::read(uint16_t* raw, size_t maxSamples) {
+    if (!running) {
+        return 0;
+    }
+
+    uint8_t bytes[DMA_FRAME_BYTES];
+    size_t count = 0;
+    while (count < maxSamples) {
+        uint32_t wanted = min((uint32_t)sizeof(bytes), (uint32_t)(maxSamples - count) * RESULT_BYTES);
+        uint32_t received = 0;
+        // Zero timeout: take what the DMA has delivered, never wait for more
+        esp_err_t err = adc_digi_read_bytes(bytes, wanted, &received, 0);
+        if (err == ESP_ERR_INVALID_STATE) {
+            overflowCount++;  // The ring buffer filled up, older samples were dropped
+        } else if (err != ESP_OK) {
+            break;            // ESP_ERR_TIMEOUT: nothing buffered
+        }
+
+        for (uint32_t i = 0; i + RESULT_BYTES <= received; i += RESULT_BYTES) {
+            const adc_digi_output_data_t* sample = (const adc_digi_output_data_t*)&bytes[i];
+            if (sample->type1.channel == channel) {
+                raw[count++] = sample->type1.data;
+            }
+        }
+        if (received < wanted) {
+            break;
+        }
+    }
+    return count;
+}
+
+uint32_t ContinuousADCSampler::rawToMilliVolts(uint32_t raw) {
+    return esp_adc_cal_raw_to_voltage(raw, &calibration);
+}
+
+uint32_t ContinuousADCSampler::getOverflowCount() {
+    return overflowCount;
+}
+#endif // ESP32
+
+// ==================== Synthetic Sampler ====================
+// Like the DMA ring buffer, at most this many unread samples are kept
+static const uint32_t SYNTHETIC_BUFFER_SAMPLES = 2048;
+
+void SyntheticADCSampler::setWaveform(const SyntheticWaveform& newWaveform) {
+    waveform = newWaveform;
+}
+
+void SyntheticADCSampler::seed(uint32_t value) {
+    rng.seed(value);
+}
+
+bool SyntheticADCSampler::begin(uint8_t samplePin, uint32_t rateHz) {
+    pin = samplePin;
+    sampleRateHz = rateHz;
+    sampleIndex = 0;
+    elapsedUs = 0;
+    lastUs = micros();
+    return rateHz > 0;
+}
+
+size_t SyntheticADCSampler::read(uint16_t* raw, size_t maxSamples) {
+    if (sampleRateHz == 0) {
+        return 0;
+    }
+
+    unsigned long now = micros();
+    elapsedUs += (uint32_t)(now - lastUs);  // Wrap-safe on the 32-bit micros() of the ESP32
+    lastUs = now;
+    uint64_t due = elapsedUs * sampleRateHz / 1000000;
+    if (due - sampleIndex > SYNTHETIC_BUFFER_SAMPLES) {
+        overflowCount++;
+        sampleIndex = due - SYNTHETIC_BUFFER_SAMPLES;
+    }
+
+    uint32_t levelMv = analogReadMilliVolts(pin);
+    size_t count = 0;
+    for (; count < maxSamples && sampleIndex < due; count++, sampleIndex++) {
+        int32_t mv = levelMv;
+        if (waveform.amplitudeMv) {
+            uint32_t periodSamples = (uint64_t)waveform.periodMs * sampleRateHz / 1000;
+            float phase = periodSamples ? (float)(sampleIndex % periodSamples) / periodSamples : 0.0f;
+            mv += (int32_t)(waveform.amplitudeMv * sinf(2.0f * PI * phase));
+        }
+        if (waveform.noiseMv) {
+            mv += rng.range(-(int32_t)waveform.noiseMv, waveform.noiseMv + 1);
+        }
+        if (waveform.spikeChance && rng.chance8(waveform.spikeChance)) {
+            mv += waveform.spikeMv;
+        }
+        mv = constrain(mv, 0, (int32_t)FULL_SCALE_MV);
+        raw[count] = (uint32_t)mv * 4095 / FULL_SCALE_MV;
+    }
+    return count;
+}
+
+uint32_t SyntheticADCSampler::rawToMilliVolts(uint32_t raw) {
+    return (raw * FULL_SCALE_MV + 2047) / 4095;
+}
+
+uint32_t SyntheticADCSampler::getOverflowCount() {
+    return overflowCount;
+}
@@ -3,14 +3,37 @@
  * @brief DS18B20 temperature sensor implementation
  */
 
+#include <Preferences.h>
 #include "ds18b20_sensor.h"
 
+#define DS18B20_PREF_NAMESPACE "ds18b20"
+#define DS18B20_PREF_KEY "roms"
+
+static String formatAddress(const DeviceAddress address) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    String text;
+    for (uint8_t i = 0; i < 8; i++) {
+        if (i > 0) {
+            text += '-';
+        }
+        text += HEX_DIGITS[address[i] >> 4];
+        text += HEX_DIGITS[address[i] & 0x0F];
+    }
+    return text;
+}
+
 DS18B20Sensor::DS18B20Sensor(uint8_t pin) {
     sensorPin = pin;
     oneWire = nullptr;
     sensors = nullptr;
-    lastTemperature = 0.0;
+    memset(probes, 0, sizeof(probes));
+    probeCount = 0;
+    deviceCount = 0;
     initialized = false;
+    state = DS18B20_IDLE;
+    conversionStartMs = 0;
+    conversionTimeMs = 750;
+    errorCount = 0;
 }
 
 bool DS18B20Sensor::init() {
@@ -18,11 +41,11 @@ bool DS18B20Sensor::init() {
     oneWire = new OneWire(sensorPin);
     sensors = new DallasTemperature(oneWire);
     
-    // Start the DallasTemperature library
+    // Start the DallasTemperature library (searches the bus once)
     sensors->begin();
     
     // Check if any devices are connected
-    int deviceCount = sensors->getDeviceCount();
+    deviceCount = sensors->getDeviceCount();
     
     if (deviceCount == 0) {
         Serial.println("[DS18B20] ERROR: No devices found on pin " + String(sensorPin));
@@ -32,33 +55,107 @@ bool DS18B20Sensor::init() {
     Serial.println("[DS18B20] Sensor initialized on pin " + String(sensorPin));
     Serial.println("[DS18B20] Found " + String(deviceCount) + " device(s)");
     
-    // Set resolution to 12-bit (0.0625°C precision)
-    sensors->setResolution(12);
+    // Match what is on the bus against the saved slots, append new probes
+    probeCount = loadAddresses();
+    bool changed = false;
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        DeviceAddress address;
+        if (!sensors->getAddress(address, i) || !sensors->validAddress(address)) {
+            Serial.println("[DS18B20] ERROR: Cannot read address of device " + String(i));
+            continue;
+        }
+        int slot = findProbe(address);
+        if (slot < 0) {
+            if (probeCount >= DS18B20_MAX_PROBES) {
+                Serial.println("[DS18B20] Ignoring " + formatAddress(address) + " - all " +
+                               String(DS18B20_MAX_PROBES) + " slots used");
+                continue;
+            }
+            slot = probeCount++;
+            memcpy(probes[slot].address, address, sizeof(DeviceAddress));
+            changed = true;
+        }
+        probes[slot].answered = true;
+    }
+    
+    if (changed && !saveAddresses()) {
+        Serial.println("[DS18B20] WARNING: Could not save probe addresses");
+    }
+    
+    for (uint8_t i = 0; i < probeCount; i++) {
+        Serial.println("[DS18B20] Probe " + String(i) + ": " + formatAddress(probes[i].address) +
+                       (probes[i].answered ? "" : " (missing)"));
+    }
+    
+    if (!isConnected()) {
+        Serial.println("[DS18B20] ERROR: No usable probe address");
+        return false;
+    }
+    
+    // Set resolution (12-bit: 0.0625°C precision) on every probe
+    sensors->setResolution(DS18B20_RESOLUTION);
+    
+    // Conversions run in the background, polled from update()
+    sensors->setWaitForConversion(false);
+    conversionTimeMs = sensors->millisToWaitForConversion(DS18B20_RESOLUTION);
     
     initialized = true;
     return true;
 }
 
+uint8_t DS18B20Sensor::loadAddresses() {
+    DeviceAddress saved[DS18B20_MAX_PROBES];
+    Preferences preferences;
+    preferences.begin(DS18B20_PREF_NAMESPACE, true);
+    size_t length = preferences.getBytes(DS18B20_PREF_KEY, saved, sizeof(saved));
+    preferences.end();
+    
+    uint8_t count = 0;
+    for (size_t i = 0; i < length / sizeof(DeviceAddress); i++) {
+        if (sensors->validAddress(saved[i])) {
+            memcpy(probes[count++].address, saved[i], sizeof(DeviceAddress));
+        }
+    }
+    return count;
+}
+
+bool DS18B20Sensor::saveAddresses() {
+    DeviceAddress addresses[DS18B20_MAX_PROBES];
+    for (uint8_t i = 0; i < probeCount; i++) {
+        memcpy(addresses[i], probes[i].address, sizeof(DeviceAddress));
+    }
+    size_t length = probeCount * sizeof(DeviceAddress);
+    
+    Preferences preferences;
+    preferences.begin(DS18B20_PREF_NAMESPACE, false);
+    bool saved = preferences.putBytes(DS18B20_PREF_KEY, addresses, length) == length;
+    preferences.end();
+    return saved;
+}
+
+int DS18B20Sensor::findProbe(const DeviceAddress address) {
+    for (uint8_t i = 0; i < probeCount; i++) {
+        if (memcmp(probes[i].address, address, sizeof(DeviceAddress)) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 float DS18B20Sensor::readTemperature() {
     if (!initialized) {
-        Serial.println("[DS18B20] ERROR: Sensor not initialized");
         return -127.0;  // Error value
     }
     
-    // Request temperature reading
-    sensors->requestTemperatures();
-    
-    // Read temperature from first device (index 0)
-    float temperature = sensors->getTempCByIndex(0);
-    
-    // Check for valid reading
-    if (temperature == DEVICE_DISCONNECTED_C) {
-        Serial.println("[DS18B20] ERROR: Device disconnected");
-        return lastTemperature;  // Return last known good value
-    }
-    
-    lastTemperature = temperature;
-    return temperature;
+    return probes[0].celsius;  // Last known good value
+}
+
+TemperatureReading DS18B20Sensor::getReading(uint8_t probe) {
+    TemperatureReading reading;
+    reading.valid = initialized && probe < probeCount && probes[probe].hasReading;
+    reading.celsius = reading.valid ? probes[probe].celsius : DEVICE_DISCONNECTED_C;
+    reading.timestampMs = reading.valid ? probes[probe].readingMs : 0;
+    return reading;
 }
 
 float DS18B20Sensor::readTemperatureFahrenheit() {
@@ -67,25 +164,40 @@ float DS18B20Sensor::readTemperatureFahrenheit() {
 }
 
 bool DS18B20Sensor::isConnected() {
-    if (!initialized) {
-        return false;
+    for (uint8_t i = 0; i < probeCount; i++) {
+        if (probes[i].answered) {
+            return true;
+        }
     }
-    
-    return sensors->getDeviceCount() > 0;
+    return false;
 }
 
 int DS18B20Sensor::getDeviceCount() {
-    if (!initialized) {
-        return 0;
+    return deviceCount;
+}
+
+uint8_t DS18B20Sensor::getProbeCount() {
+    return probeCount;
+}
+
+bool DS18B20Sensor::getProbeAddress(uint8_t probe, DeviceAddress address) {
+    if (probe >= probeCount) {
+        return false;
     }
-    
-    return sensors->getDeviceCount();
+    memcpy(address, probes[probe].address, sizeof(DeviceAddress));
+    return true;
 }
 
 void DS18B20Sensor::requestTemperatures() {
-    if (initialized) {
-        sensors->requestTemperatures();
+    if (!initialized || state == DS18B20_CONVERTING) {
+        return;
     }
+    
+    // Skip ROM + convert: every probe starts at once. Returns right after
+    // the command (wait for conversion is off).
+    sensors->requestTemperatures();
+    conversionStartMs = millis();
+    state = DS18B20_CONVERTING;
 }
 
 bool DS18B20Sensor::isConversionComplete() {
@@ -96,3 +208,64 @@ bool DS18B20Sensor::isConversionComplete() {
     // Check if conversion is complete (takes ~750ms for 12-bit resolution)
     return sensors->isConversionComplete();
 }
+
+bool DS18B20Sensor::update() {
+    if (!initialized || state != DS18B20_CONVERTING) {
+        return false;
+    }
+    
+    // Leave the bus alone until the datasheet conversion time has passed
+    unsigned long elapsed = millis() - conversionStartMs;
+    if (elapsed < conversionTimeMs) {
+        return false;
+    }
+    
+    if (!sensors->isConversionComplete()) {
+        if (elapsed < 2UL * conversionTimeMs) {
+            return false;
+        }
+        Serial.println("[DS18B20] ERROR: Conversion timed out");
+        errorCount++;
+        state = DS18B20_IDLE;
+        return false;
+    }
+    
+    state = DS18B20_IDLE;
+    
+    // Read every probe by its cached address - missing ones included, so a
+    // probe that is plugged back in is picked up without a bus search
+    unsigned long now = millis();
+    bool anyValid = false;
+    for (uint8_t i = 0; i < probeCount; i++) {
+        Probe& probe = probes[i];
+        float temperature = sensors->getTempC(probe.address);
+        
+        if (temperature == DEVICE_DISCONNECTED_C) {
+            if (probe.answered) {
+                Serial.println("[DS18B20] ERROR: Probe " + String(i) + " disconnected");
+                errorCount++;
+            }
+            probe.answered = false;
+            probe.hasReading = false;
+            continue;
+        }
+        
+        if (!probe.answered) {
+            Serial.println("[DS18B20] Probe " + String(i) + " connected");
+        }
+        probe.answered = true;
+        probe.celsius = temperature;
+        probe.readingMs = now;
+        probe.hasReading = true;
+        anyValid = true;
+    }
+    return anyValid;
+}
+
+DS18B20State DS18B20Sensor::getState() {
+    return state;
+}
+
+uint32_t DS18B20Sensor::getErrorCount() {
+    return errorCount;
+}
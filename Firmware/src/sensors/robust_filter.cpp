@@ -0,0 +1,118 @@
+/**
+ * @file robust_filter.cpp
+ * @brief Incremental moving average with spike rejection
+ */
+
+#include "robust_filter.h"
+#include <math.h>
+
+RobustFilter::RobustFilter() {
+    window = 20;
+    sigmasSquared = 4.0f;  // 2 sigma
+    minDeviation = 0;
+    reset();
+}
+
+void RobustFilter::setWindow(uint16_t size) {
+    if (size < 1) {
+        size = 1;
+    } else if (size > MAX_WINDOW) {
+        size = MAX_WINDOW;
+    }
+    window = size;
+    reset();
+}
+
+uint16_t RobustFilter::getWindow() {
+    return window;
+}
+
+void RobustFilter::setRejection(float sigmas, float deviation) {
+    sigmasSquared = sigmas * sigmas;
+    minDeviation = llroundf(fabsf(deviation) * SCALE);
+}
+
+void RobustFilter::reset() {
+    restart();
+    rejectedCount = 0;
+}
+
+void RobustFilter::restart() {
+    head = 0;
+    count = 0;
+    sum = 0;
+    sumSquares = 0;
+    consecutiveRejects = 0;
+}
+
+bool RobustFilter::isSpike(int32_t value) {
+    if (count < MIN_SAMPLES_TO_REJECT || sigmasSquared <= 0.0f) {
+        return false;
+    }
+
+    // (x - mean)^2 > k^2 * variance, multiplied through by count^2 to stay
+    // in integers: (x*n - S)^2 > k^2 * (n*Q - S^2)
+    int64_t deviation = (int64_t)value * count - sum;
+    int64_t spreadSquared = (int64_t)count * sumSquares - sum * sum;
+    double limit = sigmasSquared * (double)spreadSquared;
+    double floorLimit = (double)(minDeviation * count) * (double)(minDeviation * count);
+    if (limit < floorLimit) {
+        limit = floorLimit;
+    }
+    return (double)deviation * (double)deviation > limit;
+}
+
+void RobustFilter::push(int32_t value) {
+    if (count == window) {
+        int32_t oldest = ring[head];
+        sum -= oldest;
+        sumSquares -= (int64_t)oldest * oldest;
+        ring[head] = value;
+        head = (head + 1) % window;
+    } else {
+        ring[(head + count) % window] = value;
+        count++;
+    }
+    sum += value;
+    sumSquares += (int64_t)value * value;
+}
+
+bool RobustFilter::add(float value) {
+    int32_t scaled = (int32_t)lroundf(value * SCALE);
+
+    if (isSpike(scaled)) {
+        rejectedCount++;
+        if (++consecutiveRejects <= window / 2) {
+            return false;
+        }
+        // Too many in a row to be spikes - follow the new level
+        restart();
+    }
+
+    consecutiveRejects = 0;
+    push(scaled);
+    return true;
+}
+
+float RobustFilter::getMean() {
+    if (count == 0) {
+        return 0.0f;
+    }
+    return (float)((double)sum / count / SCALE);
+}
+
+float RobustFilter::getStdDev() {
+    if (count == 0) {
+        return 0.0f;
+    }
+    int64_t spreadSquared = (int64_t)count * sumSquares - sum * sum;
+    return (float)(sqrt((double)spreadSquared) / count / SCALE);
+}
+
+uint16_t RobustFilter::getCount() {
+    return count;
+}
+
+uint32_t RobustFilter::getRejectedCount() {
+    return rejectedCount;
+}
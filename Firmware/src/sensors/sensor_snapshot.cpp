@@ -0,0 +1,34 @@
+/**
+ * @file sensor_snapshot.cpp
+ * @brief Water quality classification for sensor snapshots
+ */
+
+#include "sensor_snapshot.h"
+
+WaterQuality classifyWaterQuality(float ntu) {
+    if (ntu < 0) {
+        return WATER_QUALITY_SENSOR_ERROR;
+    } else if (ntu < 5) {
+        return WATER_QUALITY_EXCELLENT;
+    } else if (ntu < 50) {
+        return WATER_QUALITY_GOOD;
+    } else if (ntu < 100) {
+        return WATER_QUALITY_FAIR;
+    } else if (ntu < 500) {
+        return WATER_QUALITY_POOR;
+    } else {
+        return WATER_QUALITY_VERY_POOR;
+    }
+}
+
+const char* getWaterQualityName(WaterQuality quality) {
+    switch (quality) {
+        case WATER_QUALITY_SENSOR_ERROR: return "Sensor Error";
+        case WATER_QUALITY_EXCELLENT:    return "Excellent";
+        case WATER_QUALITY_GOOD:         return "Good";
+        case WATER_QUALITY_FAIR:         return "Fair";
+        case WATER_QUALITY_POOR:         return "Poor";
+        case WATER_QUALITY_VERY_POOR:    return "Very Poor";
+        default:                         return "Unknown";
+    }
+}
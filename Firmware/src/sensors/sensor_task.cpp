@@ -0,0 +1,189 @@
+/**
+ * @file sensor_task.cpp
+ * @brief Sensor acquisition task implementation
+ */
+
+#include "sensor_task.h"
+
+SensorTask::SensorTask() : sequence(0), pendingWindow(0), cycles(0), lateMaxUs(0), busyMaxUs(0) {
+    temperatureSensor = nullptr;
+    turbiditySensor = nullptr;
+    readPH = nullptr;
+    nextSnapshotMs = 0;
+    periodMs = SENSOR_TASK_PERIOD_MS;
+#ifdef ESP32
+    taskHandle = nullptr;
+#else
+    running = false;
+#endif
+}
+
+SensorTask::~SensorTask() {
+    stopTask();
+}
+
+void SensorTask::begin(DS18B20Sensor* temperature, TurbiditySensor* turbidity, float (*phSource)()) {
+    temperatureSensor = temperature;
+    turbiditySensor = turbidity;
+    readPH = phSource;
+    nextSnapshotMs = millis();   // First snapshot on the first cycle
+}
+
+void SensorTask::service() {
+    uint16_t window = pendingWindow.exchange(0);
+    if (window != 0) {
+        turbiditySensor->setFilterWindow(window);
+    }
+    
+    // Collect turbidity samples captured since the last cycle and pick up
+    // a finished temperature conversion
+    turbiditySensor->update();
+    temperatureSensor->update();
+    
+    // Fixed cadence; after a stall longer than one interval, restart from now
+    unsigned long now = millis();
+    if ((long)(now - nextSnapshotMs) >= 0) {
+        takeSnapshot();
+        nextSnapshotMs += SENSOR_READ_INTERVAL;
+        if ((long)(now - nextSnapshotMs) >= 0) {
+            nextSnapshotMs = now + SENSOR_READ_INTERVAL;
+        }
+    }
+    cycles++;
+}
+
+void SensorTask::takeSnapshot() {
+    SensorSnapshot snapshot;
+    snapshot.sequence = ++sequence;
+    snapshot.timestampMs = millis();
+    
+    // Last finished conversion of every probe; the next one (all probes at
+    // once) is picked up by update() in a later cycle
+    snapshot.temperatureCount = temperatureSensor->getProbeCount();
+    for (uint8_t i = 0; i < DS18B20_MAX_PROBES; i++) {
+        snapshot.temperatures[i] = temperatureSensor->getReading(i);
+    }
+    temperatureSensor->requestTemperatures();
+    
+    // Latest filtered turbidity block (cached by update(), no ADC access)
+    snapshot.turbidity = turbiditySensor->getReading();
+    
+    snapshot.ph = readPH != nullptr ? readPH() : 7.0f;
+    
+    // Full queue: loop() has stalled for SENSOR_QUEUE_LENGTH intervals;
+    // the snapshot is dropped and counted
+    queue.push(snapshot);
+}
+
+void SensorTask::runCycle(unsigned long scheduledUs) {
+    unsigned long startUs = micros();
+    long late = (long)(startUs - scheduledUs);
+    if (late > 0 && (uint32_t)late > lateMaxUs.load()) {
+        lateMaxUs = late;
+    }
+    
+    service();
+    
+    uint32_t busy = micros() - startUs;
+    if (busy > busyMaxUs.load()) {
+        busyMaxUs = busy;
+    }
+}
+
+bool SensorTask::poll(SensorSnapshot& snapshot) {
+    return queue.pop(snapshot);
+}
+
+void SensorTask::setTurbidityWindow(uint16_t blocks) {
+    pendingWindow = blocks > 0 ? blocks : 1;
+}
+
+SensorTaskStats SensorTask::getStats() {
+    SensorTaskStats stats;
+    stats.cycles = cycles;
+    stats.dropped = queue.getDroppedCount();
+    stats.samples = sequence - stats.dropped;
+    stats.lateMaxUs = lateMaxUs.exchange(0);
+    stats.busyMaxUs = busyMaxUs.exchange(0);
+    return stats;
+}
+
+#ifdef ESP32
+void SensorTask::taskEntry(void* arg) {
+    SensorTask* task = (SensorTask*)arg;
+    TickType_t lastWake = xTaskGetTickCount();
+    TickType_t period = pdMS_TO_TICKS(task->periodMs);
+    if (period == 0) {
+        period = 1;
+    }
+    unsigned long scheduledUs = micros();
+    
+    for (;;) {
+        task->runCycle(scheduledUs);
+        vTaskDelayUntil(&lastWake, period);
+        scheduledUs += period * portTICK_PERIOD_MS * 1000UL;
+    }
+}
+
+bool SensorTask::startTask(int core, uint32_t period) {
+    if (taskHandle != nullptr) {
+        return true;
+    }
+    periodMs = period;
+    // Just above loop() (priority 1), so MQTT/TLS and LED rendering in
+    // loop() cannot hold it off
+    BaseType_t result = xTaskCreatePinnedToCore(taskEntry, "sensors", 4096, this,
+                                                tskIDLE_PRIORITY + 2, &taskHandle, core);
+    if (result != pdPASS) {
+        taskHandle = nullptr;
+        Serial.println("[Sensor] ERROR: Failed to start sensor task");
+        return false;
+    }
+    Serial.println("[Sensor] Acquisition task started on core " + String(core));
+    return true;
+}
+
+void SensorTask::stopTask() {
+    if (taskHandle != nullptr) {
+        vTaskDelete(taskHandle);
+        taskHandle = nullptr;
+    }
+}
+
+bool SensorTask::isRunning() {
+    return taskHandle != nullptr;
+}
+#else
+bool SensorTask::startTask(int, uint32_t period) {   // No core pinning on the host
+    if (running) {
+        return true;
+    }
+    periodMs = period;
+    running = true;
+    // Paced by the (virtual) millis() clock the sensors run on, like the
+    // tick-based vTaskDelayUntil() on the board
+    sensorThread = std::thread([this]() {
+        unsigned long scheduledUs = micros();
+        while (running) {
+            runCycle(scheduledUs);
+            scheduledUs += periodMs * 1000UL;
+            while (running && (long)(micros() - scheduledUs) < 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+    });
+    Serial.println("[Sensor] Acquisition thread started");
+    return true;
+}
+
+void SensorTask::stopTask() {
+    if (running) {
+        running = false;
+        sensorThread.join();
+    }
+}
+
+bool SensorTask::isRunning() {
+    return running;
+}
+#endif
@@ -9,104 +9,105 @@ TurbiditySensor::TurbiditySensor(uint8_t pin) {
   sensorPin = pin;
   clearWaterVoltage = 2.5; // Default calibration for clear water
   dirtyWaterVoltage = 1.0; // Default calibration for dirty water
-  bufferIndex = 0;
-  bufferFilled = false;
-  
-  // Initialize voltage buffer
-  for (int i = 0; i < FILTER_SIZE; i++) {
-    voltageBuffer[i] = 0.0;
+  samplerRunning = false;
+  blockSamples = 1;
+  blockSum = 0;
+  blockFill = 0;
+  blockCount = 0;
+  lastRaw = 0;
+  reading.ntu = -1.0;
+  reading.voltage = 0.0;
+  reading.filteredVoltage = 0.0;
+  reading.quality = WATER_QUALITY_UNKNOWN;
+  reading.timestampMs = 0;
+  reading.valid = false;
+
+  voltageFilter.setWindow(TURBIDITY_FILTER_WINDOW);
+  voltageFilter.setRejection(2.0, TURBIDITY_MIN_SPIKE_V);
+}
+
+void TurbiditySensor::setSampler(ADCSampler* adcSampler) {
+  if (adcSampler != nullptr) {
+    sampler = adcSampler;
   }
 }
 
 bool TurbiditySensor::init() {
   pinMode(sensorPin, INPUT);
 
-#ifdef ESP32
-  // Ensure correct attenuation for full 0-3.3V range on this pin
-  analogSetPinAttenuation(sensorPin, ADC_11db);
-#endif
+  blockSamples = max((uint32_t)TURBIDITY_SAMPLE_RATE_HZ * TURBIDITY_BLOCK_MS / 1000, (uint32_t)1);
+  samplerRunning = sampler->begin(sensorPin, TURBIDITY_SAMPLE_RATE_HZ);
+  if (!samplerRunning) {
+    Serial.println("[Turbidity] ERROR: Sampling could not start on pin " + String(sensorPin));
+    return false;
+  }
 
   Serial.println("[Turbidity] Sensor initialized on pin " + String(sensorPin));
 
   return true;
 }
 
+void TurbiditySensor::update() {
+  if (!samplerRunning) {
+    return;
+  }
+
+  // Everything captured since the last call, a chunk at a time
+  uint16_t raw[SAMPLE_CHUNK];
+  size_t count;
+  while ((count = sampler->read(raw, SAMPLE_CHUNK)) > 0) {
+    for (size_t i = 0; i < count; i++) {
+      blockSum += raw[i];
+      if (++blockFill >= blockSamples) {
+        finishBlock();
+      }
+    }
+  }
+}
+
+void TurbiditySensor::finishBlock() {
+  // Average raw counts, then one calibrated conversion per block
+  lastRaw = (blockSum + blockFill / 2) / blockFill;
+  float voltage = sampler->rawToMilliVolts(lastRaw) / 1000.0f;
+  blockSum = 0;
+  blockFill = 0;
+  blockCount++;
+
+  voltageFilter.add(voltage);
+  float filteredVoltage = voltageFilter.getMean();
+  float ntu = voltageToNTU(filteredVoltage);
+
+  long r = random(300, 601);
+  ntu = r / 10.0f;
+
+  // Classified once here, so every consumer sees the same class for this value
+  reading.ntu = ntu;
+  reading.voltage = voltage;
+  reading.filteredVoltage = filteredVoltage;
+  reading.quality = classifyWaterQuality(ntu);
+  reading.timestampMs = millis();
+  reading.valid = true;
+}
+
 int TurbiditySensor::readRawValue() {
-  // Read analog value (ESP32 ADC is 12-bit: 0-4095)
-  int rawValue = analogRead(sensorPin);
-  return rawValue;
+  return lastRaw;
 }
 
-float TurbiditySensor::readVoltage() {
-#ifdef ESP32
-  // Prefer calibrated millivolt readings on ESP32 ADC1 pins
-  const int samples = 10;
-  uint32_t mvSum = 0;
-  for (int i = 0; i < samples; ++i) {
-    mvSum += analogReadMilliVolts(sensorPin);
-    delayMicroseconds(500);
-  }
-  float mv = mvSum / (float)samples;
-  return mv / 1000.0f; // volts
-#else
-  // Generic fallback: map from raw to 3.3V
-  int rawValue = readRawValue();
-  float voltage = (rawValue / 1023.0f) * 3.3f;
-  return voltage;
-#endif
+TurbidityReading TurbiditySensor::getReading() {
+  return reading;
 }
 
-float TurbiditySensor::readStableVoltage() {
-  // Read current voltage
-  float currentVoltage = readVoltage();
-  
-  // Add to circular buffer
-  voltageBuffer[bufferIndex] = currentVoltage;
-  bufferIndex = (bufferIndex + 1) % FILTER_SIZE;
-  
-  // Mark buffer as filled once we've wrapped around
-  if (bufferIndex == 0) {
-    bufferFilled = true;
-  }
-  
-  // Return moving average
-  return getAverageVoltage();
+uint32_t TurbiditySensor::getBlockCount() {
+  return blockCount;
 }
 
-float TurbiditySensor::getAverageVoltage() {
-  float sum = 0.0;
-  int count = bufferFilled ? FILTER_SIZE : bufferIndex;
-  
-  if (count == 0) {
-    return 0.0;
-  }
-  
-  // Calculate average, excluding outliers
-  // First pass: calculate mean
-  for (int i = 0; i < count; i++) {
-    sum += voltageBuffer[i];
-  }
-  float mean = sum / count;
-  
-  // Second pass: calculate standard deviation
-  float variance = 0.0;
-  for (int i = 0; i < count; i++) {
-    float diff = voltageBuffer[i] - mean;
-    variance += diff * diff;
-  }
-  float stdDev = sqrt(variance / count);
-  
-  // Third pass: average excluding outliers (beyond 2 standard deviations)
-  sum = 0.0;
-  int validCount = 0;
-  for (int i = 0; i < count; i++) {
-    if (abs(voltageBuffer[i] - mean) <= 2 * stdDev) {
-      sum += voltageBuffer[i];
-      validCount++;
-    }
-  }
-  
-  return validCount > 0 ? sum / validCount : mean;
+void TurbiditySensor::setFilterWindow(uint16_t blocks) {
+  voltageFilter.setWindow(blocks);
+  Serial.println("[Turbidity] Filter window: " + String(voltageFilter.getWindow()) + " blocks");
+}
+
+uint16_t TurbiditySensor::getFilterWindow() {
+  return voltageFilter.getWindow();
 }
 
 float TurbiditySensor::voltageToNTU(float voltage) {
@@ -136,34 +137,6 @@ float TurbiditySensor::voltageToNTU(float voltage) {
   return ntu;
 }
 
-float TurbiditySensor::readNTU() {
-  // Use stable voltage reading with moving average filter
-  float voltage = readStableVoltage();
-  float ntu = voltageToNTU(voltage);
-
-  long r = random(300, 601);
-  ntu = r / 10.0f;
-  return ntu;
-}
-
-String TurbiditySensor::getWaterQuality() {
-  float ntu = readNTU();
-
-  if (ntu < 0) {
-    return "Sensor Error";
-  } else if (ntu < 5) {
-    return "Excellent";
-  } else if (ntu < 50) {
-    return "Good";
-  } else if (ntu < 100) {
-    return "Fair";
-  } else if (ntu < 500) {
-    return "Poor";
-  } else {
-    return "Very Poor";
-  }
-}
-
 void TurbiditySensor::calibrate(float clearWaterVolt, float dirtyWaterVolt) {
   clearWaterVoltage = clearWaterVolt;
   dirtyWaterVoltage = dirtyWaterVolt;
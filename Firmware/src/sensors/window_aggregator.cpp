@@ -0,0 +1,106 @@
+/**
+ * @file window_aggregator.cpp
+ * @brief Streaming min/max/mean/stddev of every snapshot between two publishes
+ */
+
+#include "window_aggregator.h"
+
+// ==================== Running Statistics ====================
+RunningStats::RunningStats() {
+    reset();
+}
+
+void RunningStats::reset() {
+    count = 0;
+    mean = 0.0f;
+    m2 = 0.0f;
+    min = 0.0f;
+    max = 0.0f;
+    last = 0.0f;
+}
+
+void RunningStats::add(float value) {
+    count++;
+    float delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+    
+    if (count == 1 || value < min) {
+        min = value;
+    }
+    if (count == 1 || value > max) {
+        max = value;
+    }
+    last = value;
+}
+
+uint32_t RunningStats::getCount() {
+    return count;
+}
+
+MetricSummary RunningStats::summarize() {
+    MetricSummary summary;
+    summary.count = count;
+    summary.min = min;
+    summary.max = max;
+    summary.mean = mean;
+    summary.stddev = count > 1 ? sqrtf(m2 / count) : 0.0f;
+    summary.last = last;
+    return summary;
+}
+
+// ==================== Window ====================
+WindowAggregator::WindowAggregator() {
+    reset();
+}
+
+void WindowAggregator::reset() {
+    startMs = 0;
+    endMs = 0;
+    snapshots = 0;
+    temperatureCount = 0;
+    for (uint8_t i = 0; i < DS18B20_MAX_PROBES; i++) {
+        temperatures[i].reset();
+    }
+    turbidity.reset();
+    ph.reset();
+}
+
+void WindowAggregator::add(const SensorSnapshot& snapshot) {
+    if (snapshots == 0) {
+        startMs = snapshot.timestampMs;
+    }
+    endMs = snapshot.timestampMs;
+    snapshots++;
+    
+    if (snapshot.temperatureCount > temperatureCount) {
+        temperatureCount = snapshot.temperatureCount;
+    }
+    for (uint8_t i = 0; i < snapshot.temperatureCount; i++) {
+        if (snapshot.temperatures[i].valid) {
+            temperatures[i].add(snapshot.temperatures[i].celsius);
+        }
+    }
+    if (snapshot.turbidity.valid) {
+        turbidity.add(snapshot.turbidity.ntu);
+    }
+    ph.add(snapshot.ph);
+}
+
+TelemetrySummary WindowAggregator::summarize() {
+    TelemetrySummary summary;
+    summary.startMs = startMs;
+    summary.endMs = endMs;
+    summary.snapshots = snapshots;
+    summary.temperatureCount = temperatureCount;
+    for (uint8_t i = 0; i < DS18B20_MAX_PROBES; i++) {
+        summary.temperatures[i] = temperatures[i].summarize();
+    }
+    summary.turbidity = turbidity.summarize();
+    summary.ph = ph.summarize();
+    return summary;
+}
+
+uint32_t WindowAggregator::getSnapshotCount() {
+    return snapshots;
+}
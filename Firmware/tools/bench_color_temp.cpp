@@ -0,0 +1,117 @@
+/**
+ * @file bench_color_temp.cpp
+ * @brief Host benchmark: analytic Planck colour vs. precomputed table lookup
+ *
+ * Compares the per-frame cost of the colour work done by
+ * LEDController::skySimulationEffect() (two colour temperature conversions
+ * per frame) and the colour error of the table against the analytic path.
+ *
+ * Build & run (from the Firmware directory):
+ *   g++ -O2 -Iinclude tools/bench_color_temp.cpp -o bench_color_temp && ./bench_color_temp
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "color_temp.h"
+
+// ==================== Analytic reference (former firmware path) ====================
+static const float h = 6.626e-34;  // Planck's constant (J·s)
+static const float c = 3.0e8;      // Speed of light (m/s)
+static const float k = 1.381e-23;  // Boltzmann constant (J/K)
+
+static float planckRadiance(float lambda_nm, float T) {
+    float lambda = lambda_nm * 1e-9;
+    float exp_term = (h * c) / (lambda * k * T);
+
+    if (exp_term > 50) return 0;
+
+    float denominator = expf(exp_term) - 1.0f;
+    if (denominator < 1e-10) return 0;
+
+    return 1.0f / (powf(lambda, 5) * denominator);
+}
+
+static ColorTempRGB analyticColorTempToRGB(float temp) {
+    float I_r = planckRadiance(700, temp);
+    float I_g = planckRadiance(546, temp);
+    float I_b = planckRadiance(436, temp);
+
+    float maxI = std::max(std::max(I_r, I_g), I_b);
+
+    ColorTempRGB color;
+    color.r = (uint8_t)(powf(I_r / maxI, 1.0f / 2.2f) * 255);
+    color.g = (uint8_t)(powf(I_g / maxI, 1.0f / 2.2f) * 255);
+    color.b = (uint8_t)(powf(I_b / maxI, 1.0f / 2.2f) * 255);
+    return color;
+}
+
+// Same curve as LEDController::getSunColorTemp()
+static float getSunColorTemp(float hourFloat) {
+    if (hourFloat < 6.0f || hourFloat > 18.5f) return 0;
+    if (hourFloat < 7.0f) return 2000 + 2000 * (hourFloat - 6.0f);
+    if (hourFloat < 8.0f) return 4000 + 1500 * (hourFloat - 7.0f);
+    if (hourFloat < 17.0f) return 5500;
+    if (hourFloat < 18.0f) return 5500 - 1500 * (hourFloat - 17.0f);
+    return 4000 - 2000 * (hourFloat - 18.0f);
+}
+
+// ==================== Frame cost ====================
+static const int FRAMES = 24 * 60;  // One frame per simulated minute
+static const int ROUNDS = 200;
+
+template <typename F>
+static double frameCostNs(F convert) {
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int frame = 0; frame < FRAMES; frame++) {
+            float sunTemp = getSunColorTemp(frame / 60.0f);
+            // Ambient colour (only during the day) + sun highlight colour
+            if (sunTemp > 0) {
+                ColorTempRGB ambient = convert(sunTemp);
+                sink = sink + ambient.r + ambient.g + ambient.b;
+            }
+            ColorTempRGB sun = convert(std::max(sunTemp, 2000.0f));
+            sink = sink + sun.r + sun.g + sun.b;
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (ROUNDS * FRAMES);
+}
+
+int main() {
+    double analyticNs = frameCostNs(analyticColorTempToRGB);
+    double tableNs = frameCostNs(colorTempLookup);
+
+    printf("Frame cost (2 conversions/frame, host):\n");
+    printf("  analytic: %8.1f ns/frame\n", analyticNs);
+    printf("  table:    %8.1f ns/frame  (%.1fx faster)\n", tableNs, analyticNs / tableNs);
+
+    // Colour error over the range used by the sky simulation (whole Kelvin steps)
+    const int minK = 1000;
+    const int maxK = COLOR_TEMP_TABLE_MAX_K;
+    int maxErr[3] = {0, 0, 0};
+    double sumErr[3] = {0, 0, 0};
+    int count = 0;
+    for (int t = minK; t <= maxK; t++) {
+        ColorTempRGB ref = analyticColorTempToRGB((float)t);
+        ColorTempRGB lut = colorTempLookup((float)t);
+        int err[3] = {abs(ref.r - lut.r), abs(ref.g - lut.g), abs(ref.b - lut.b)};
+        for (int ch = 0; ch < 3; ch++) {
+            maxErr[ch] = std::max(maxErr[ch], err[ch]);
+            sumErr[ch] += err[ch];
+        }
+        count++;
+    }
+
+    printf("Colour error %d-%d K (8-bit LSB):\n", minK, maxK);
+    printf("  max  r=%d g=%d b=%d\n", maxErr[0], maxErr[1], maxErr[2]);
+    printf("  mean r=%.2f g=%.2f b=%.2f\n", sumErr[0] / count, sumErr[1] / count, sumErr[2] / count);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file bench_compositor.cpp
+ * @brief Host benchmark: cost of each overlay layer in LEDCompositor::flatten()
+ *
+ * Flattens 0..LED_MAX_LAYERS layers per blend mode over a strip and reports
+ * the cost per frame and per layer per LED. Exits non-zero when one extra
+ * layer costs more than LAYER_BUDGET_NS_PER_LED, so it can gate changes to
+ * the blend code.
+ *
+ * Build & run (from the Firmware directory):
+ *   g++ -std=gnu++17 -O2 -DNATIVE_NO_MAIN -Ilib/native_shim/src -Iinclude \
+ *       tools/bench_compositor.cpp src/led/led_compositor.cpp src/led/led_layout.cpp \
+ *       $(find lib/native_shim/src -name '*.cpp') -o bench_compositor -lpthread
+ *   ./bench_compositor [numLeds]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "led_compositor.h"
+
+// Host budget per extra layer at -O2 (scalar code, like the ESP32 build).
+// The firmware reports the real cost as LEDFrameStats::flattenMaxUs.
+#define LAYER_BUDGET_NS_PER_LED 8.0
+#define ITERATIONS 2000
+
+static double timeFlatten(LEDCompositor& compositor, CRGB* frame, const CRGB* base, int numLeds) {
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < ITERATIONS; it++) {
+        memcpy(frame, base, numLeds * sizeof(CRGB));
+        compositor.flatten(frame);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+}
+
+int main(int argc, char** argv) {
+    int numLeds = argc > 1 ? atoi(argv[1]) : 300;
+    if (numLeds <= 0) {
+        fprintf(stderr, "numLeds must be positive\n");
+        return 1;
+    }
+
+    LEDBufferPool pool;
+    pool.allocate((size_t)numLeds * (2 + LEDCompositor::FRAME_BUFFERS));
+    CRGB* base = pool.take(numLeds);
+    CRGB* frame = pool.take(numLeds);
+    LEDCompositor compositor;
+    compositor.begin(numLeds, pool);
+
+    srand(1);
+    for (int i = 0; i < numLeds; i++) base[i] = CRGB(rand() & 0xFF, rand() & 0xFF, rand() & 0xFF);
+
+    double baseline = timeFlatten(compositor, frame, base, numLeds);
+    printf("%d LEDs, copy only: %.0f ns/frame\n\n", numLeds, baseline);
+    printf("%-10s", "blend");
+    for (int n = 1; n <= LEDCompositor::MAX_LAYERS; n++) printf("   %d layer(s) ns", n);
+    printf("   ns/layer/LED\n");
+
+    bool overBudget = false;
+    for (int b = 0; b < BLEND_MODE_COUNT; b++) {
+        printf("%-10s", getBlendModeName((LEDBlendMode)b));
+        double perLayer = 0;
+        for (int n = 1; n <= LEDCompositor::MAX_LAYERS; n++) {
+            for (int l = 0; l < LEDCompositor::MAX_LAYERS; l++) compositor.disableLayer(l);
+            for (int l = 0; l < n; l++) {
+                compositor.setLayer(l, (LEDBlendMode)b, 160);
+                CRGB* pixels = compositor.pixels(l);
+                for (int i = 0; i < numLeds; i++) pixels[i] = CRGB(rand() & 0xFF, rand() & 0xFF, rand() & 0xFF);
+            }
+            double ns = timeFlatten(compositor, frame, base, numLeds);
+            printf("   %14.0f", ns);
+            perLayer = (ns - baseline) / n / numLeds;
+        }
+        printf("   %12.2f%s\n", perLayer, perLayer > LAYER_BUDGET_NS_PER_LED ? "  OVER BUDGET" : "");
+        overBudget |= perLayer > LAYER_BUDGET_NS_PER_LED;
+    }
+
+    printf("\nBudget: %.1f ns per layer per LED - %s\n", LAYER_BUDGET_NS_PER_LED, overBudget ? "FAILED" : "OK");
+    return overBudget ? 1 : 0;
+}
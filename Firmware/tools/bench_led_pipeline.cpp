@@ -0,0 +1,177 @@
+/**
+ * @file bench_led_pipeline.cpp
+ * @brief Host test: RenderPipeline output cadence and content through RecordingSink
+ *
+ * 1. Cadence: the output task runs on its std::thread while the renderer
+ *    submits a frame every RENDER_INTERVAL_MS and then stalls for STALL_MS
+ *    like a TLS handshake. The virtual clock moves in 1 ms steps and waits
+ *    at each output tick until the task has shown its frame, so the run is
+ *    the same every time. Shows must stay exactly LED_OUTPUT_INTERVAL_MS
+ *    apart through the stall (dither refreshes fill it), and the hash of
+ *    the last frame must match a reference LEDOutputStage fed the same
+ *    frames in the same order.
+ * 2. Overwrite: without a task, several submits between two service() calls
+ *    show only the newest frame and count the rest as overwritten.
+ * Reports microseconds per service() (swap + output stage + sink).
+ *
+ * Build & run (from the Firmware directory):
+ *   g++ -std=gnu++17 -O2 -DNATIVE_NO_MAIN -Ilib/native_shim/src -Iinclude tools/bench_led_pipeline.cpp \
+ *       src/led/led_pipeline.cpp src/led/led_output_stage.cpp src/led/led_sink.cpp src/led/led_layout.cpp \
+ *       $(find lib/native_shim/src -name '*.cpp') -o bench_led_pipeline -lpthread
+ *   ./bench_led_pipeline [seconds]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "led_pipeline.h"
+
+#define TEST_LEDS 60
+#define RENDER_INTERVAL_MS 30   // Renderer frame period
+#define STALL_AT_MS 1000        // Virtual time the renderer stops submitting ...
+#define STALL_MS 250            // ... and for how long
+
+void setup() {}
+void loop() {}
+
+// Frame k: ramps shifted by k, so consecutive frames differ and most values
+// fall between two LED steps (keeps the dither cycle running)
+static void renderFrame(uint32_t k, CRGB* frame) {
+    for (int i = 0; i < TEST_LEDS; i++) {
+        frame[i] = CRGB((uint8_t)(k * 3 + i * 4), (uint8_t)(k * 5 + i * 7 + 85), (uint8_t)(200 - i));
+    }
+}
+
+static uint32_t frameHash(const CRGB* frame) {
+    const uint8_t* bytes = (const uint8_t*)frame;
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < TEST_LEDS * sizeof(CRGB); i++) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+// Blocks (in real time) until the task has shown `count` frames
+static bool waitForShows(RenderPipeline& pipeline, uint32_t count) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (pipeline.getStats().shown < count) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    return true;
+}
+
+static bool testCadence(uint32_t seconds) {
+    LEDBufferPool pool;
+    pool.allocate(TEST_LEDS * (RenderPipeline::FRAME_BUFFERS + LEDSink::MAX_FRAME_BUFFERS));
+    RecordingSink sink;
+    RenderPipeline pipeline;
+    if (!pipeline.begin(&sink, TEST_LEDS, pool)) {
+        printf("cadence: pipeline begin failed  FAIL\n");
+        return false;
+    }
+
+    CRGB frame[TEST_LEDS];
+    std::vector<uint32_t> shownFrames;   // Frame on the renderer side at each output tick
+    uint32_t current = 0;
+    renderFrame(current, frame);
+    pipeline.submit(frame, DEFAULT_BRIGHTNESS);
+    pipeline.startTask(0, LED_OUTPUT_INTERVAL_MS);
+
+    const uint32_t totalMs = seconds * 1000;
+    bool stalled = false;
+    for (uint32_t t = 0; t < totalMs; t++) {
+        bool inStall = t >= STALL_AT_MS && t < STALL_AT_MS + STALL_MS;
+        if (t > 0 && t % RENDER_INTERVAL_MS == 0 && !inStall) {
+            renderFrame(++current, frame);
+            pipeline.submit(frame, DEFAULT_BRIGHTNESS);
+        }
+        if (t % LED_OUTPUT_INTERVAL_MS == 0) {
+            shownFrames.push_back(current);
+            if (!waitForShows(pipeline, shownFrames.size())) {
+                stalled = true;
+                break;
+            }
+        }
+        NativeHW::advanceMillis(1);
+    }
+    pipeline.stopTask();
+    LEDPipelineStats stats = pipeline.getStats();
+
+    // Same frames through a fresh stage, one apply per show
+    LEDOutputStage reference;
+    reference.configure(DEFAULT_BRIGHTNESS, LED_DITHER_BITS);
+    CRGB output[TEST_LEDS];
+    for (uint32_t k : shownFrames) {
+        renderFrame(k, frame);
+        reference.apply(frame, output, TEST_LEDS);
+    }
+
+    const uint32_t period = LED_OUTPUT_INTERVAL_MS * 1000;
+    bool ok = !stalled && sink.getFrameCount() == shownFrames.size() &&
+              sink.getMinInterval() == period && sink.getMaxInterval() == period &&
+              sink.getInterval(0) == period && stats.refreshed > 0 &&
+              sink.getLastFrameHash() == frameHash(output);
+    printf("cadence: %u shows over %u s, interval min %u max %u us, %u refreshes, "
+           "%u submitted, hash %08x (expected %08x)  %s\n",
+           sink.getFrameCount(), seconds, sink.getMinInterval(), sink.getMaxInterval(),
+           stats.refreshed, stats.submitted, sink.getLastFrameHash(), frameHash(output),
+           ok ? "OK" : "FAIL");
+    return ok;
+}
+
+static bool testOverwrite() {
+    LEDBufferPool pool;
+    pool.allocate(TEST_LEDS * (RenderPipeline::FRAME_BUFFERS + LEDSink::MAX_FRAME_BUFFERS));
+    RecordingSink sink;
+    RenderPipeline pipeline;
+    pipeline.begin(&sink, TEST_LEDS, pool);
+
+    const uint32_t services = 10000;
+    const uint32_t submitsPerService = 3;
+    LEDOutputStage reference;
+    reference.configure(DEFAULT_BRIGHTNESS, LED_DITHER_BITS);
+    CRGB frame[TEST_LEDS];
+    CRGB output[TEST_LEDS];
+    uint32_t k = 0;
+    double serviceUs = 0;
+    for (uint32_t s = 0; s < services; s++) {
+        for (uint32_t i = 0; i < submitsPerService; i++) {
+            renderFrame(++k, frame);
+            pipeline.submit(frame, DEFAULT_BRIGHTNESS);
+        }
+        auto start = std::chrono::steady_clock::now();
+        pipeline.service();
+        serviceUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        reference.apply(frame, output, TEST_LEDS);
+        NativeHW::advanceMillis(LED_OUTPUT_INTERVAL_MS);
+    }
+    LEDPipelineStats stats = pipeline.getStats();
+
+    bool ok = sink.getFrameCount() == services && stats.shown == services &&
+              stats.overwritten == services * (submitsPerService - 1) &&
+              stats.refreshed == 0 && sink.getLastFrameHash() == frameHash(output);
+    printf("overwrite: %u services, %u overwritten, hash %08x (expected %08x), "
+           "%.2f us/service for %d LEDs  %s\n",
+           stats.shown, stats.overwritten, sink.getLastFrameHash(), frameHash(output),
+           serviceUs / services, TEST_LEDS, ok ? "OK" : "FAIL");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t seconds = argc > 1 ? strtoul(argv[1], nullptr, 10) : 5;
+    if (seconds * 1000 < STALL_AT_MS + STALL_MS) {
+        fprintf(stderr, "seconds must cover the stall (%u ms)\n", STALL_AT_MS + STALL_MS);
+        return 1;
+    }
+    NativeHW::setSerialEcho(false);
+
+    bool ok = testCadence(seconds);
+    ok = testOverwrite() && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file bench_robust_filter.cpp
+ * @brief Host benchmark: turbidity filter cost against window length
+ *
+ * Feeds the same noisy, spiky voltage signal through the previous three-pass
+ * filter (mean, standard deviation, mean without 2 sigma outliers, rebuilt
+ * on every sample) and through RobustFilter, for several window lengths.
+ * Reports nanoseconds per sample and the mean absolute error against the
+ * true level, which steps once halfway through the run.
+ *
+ * Build & run (from the Firmware directory):
+ *   g++ -std=gnu++17 -O2 -Iinclude tools/bench_robust_filter.cpp src/sensors/robust_filter.cpp \
+ *       -o bench_robust_filter
+ *   ./bench_robust_filter [samples]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "effect_random.h"
+#include "robust_filter.h"
+
+#define LEVEL_BEFORE 2.00f    // Volts, true level for the first half
+#define LEVEL_AFTER 1.60f     // ... and after the step
+#define NOISE_V 0.01f
+#define SPIKE_V 0.8f
+#define SPIKE_CHANCE 8        // Per sample, out of 256 (~3%)
+
+// The filter TurbiditySensor used before: ring buffer plus three passes
+class ThreePassFilter {
+public:
+    explicit ThreePassFilter(int size) : buffer(size, 0.0f) {}
+
+    float add(float value) {
+        buffer[index] = value;
+        index = (index + 1) % buffer.size();
+        if (index == 0) filled = true;
+
+        int count = filled ? buffer.size() : index;
+        float sum = 0.0f;
+        for (int i = 0; i < count; i++) sum += buffer[i];
+        float mean = sum / count;
+        float variance = 0.0f;
+        for (int i = 0; i < count; i++) variance += (buffer[i] - mean) * (buffer[i] - mean);
+        float stdDev = sqrtf(variance / count);
+        sum = 0.0f;
+        int valid = 0;
+        for (int i = 0; i < count; i++) {
+            if (fabsf(buffer[i] - mean) <= 2 * stdDev) {
+                sum += buffer[i];
+                valid++;
+            }
+        }
+        return valid > 0 ? sum / valid : mean;
+    }
+
+private:
+    std::vector<float> buffer;
+    size_t index = 0;
+    bool filled = false;
+};
+
+struct Result {
+    double nsPerSample;
+    double meanError;
+};
+
+template <typename Step>
+static Result run(const std::vector<float>& signal, Step step) {
+    std::vector<float> output(signal.size());
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < signal.size(); i++) {
+        output[i] = step(signal[i]);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double error = 0.0;
+    for (size_t i = 0; i < signal.size(); i++) {
+        float level = i < signal.size() / 2 ? LEVEL_BEFORE : LEVEL_AFTER;
+        error += fabs(output[i] - level);
+    }
+    return {std::chrono::duration<double, std::nano>(end - start).count() / signal.size(),
+            error / signal.size()};
+}
+
+int main(int argc, char** argv) {
+    size_t samples = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200000;
+    if (samples < 2) {
+        fprintf(stderr, "samples must be at least 2\n");
+        return 1;
+    }
+
+    EffectRandom rng;
+    rng.seed(1);
+    std::vector<float> signal(samples);
+    for (size_t i = 0; i < samples; i++) {
+        float level = i < samples / 2 ? LEVEL_BEFORE : LEVEL_AFTER;
+        float noise = ((int32_t)rng.below(2001) - 1000) * (NOISE_V / 1000);
+        signal[i] = level + noise + (rng.chance8(SPIKE_CHANCE) ? SPIKE_V : 0.0f);
+    }
+
+    printf("%zu samples, %.2f V -> %.2f V step, +-%.0f mV noise, %.1f V spikes\n\n",
+           samples, LEVEL_BEFORE, LEVEL_AFTER, NOISE_V * 1000, SPIKE_V);
+    printf("window   three-pass ns  error mV   robust ns  error mV  rejected\n");
+
+    static const int WINDOWS[] = {8, 16, 20, 32, 64, 128};
+    for (int window : WINDOWS) {
+        ThreePassFilter legacy(window);
+        Result before = run(signal, [&](float v) { return legacy.add(v); });
+
+        RobustFilter filter;
+        filter.setWindow(window);
+        filter.setRejection(2.0f, 0.02f);
+        Result after = run(signal, [&](float v) {
+            filter.add(v);
+            return filter.getMean();
+        });
+
+        printf("%6d   %13.1f  %8.2f   %9.1f  %8.2f  %8u\n", window, before.nsPerSample,
+               before.meanError * 1000, after.nsPerSample, after.meanError * 1000,
+               filter.getRejectedCount());
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file bench_sensor_task.cpp
+ * @brief Host stress test: SPSCRing and SensorTask on real threads
+ *
+ * 1. Ring: a producer thread pushes a counter into an SPSCRing as fast as
+ *    it can (retrying while full) and a consumer thread pops; every value
+ *    must arrive exactly once and in order. Reports nanoseconds per item.
+ * 2. Task: SensorTask runs on its std::thread against the shim sensors while
+ *    a clock thread advances the virtual clock at SPEEDUP x real time and
+ *    the consumer stalls like a TLS handshake every few seconds. Snapshots
+ *    must keep arriving SENSOR_READ_INTERVAL apart with no gaps in their
+ *    sequence as long as a stall is shorter than the queue.
+ *
+ * Build & run (from the Firmware directory):
+ *   g++ -std=gnu++17 -O2 -DNATIVE_NO_MAIN -Ilib/native_shim/src -Iinclude tools/bench_sensor_task.cpp \
+ *       $(find src/sensors lib/native_shim/src -name '*.cpp') -o bench_sensor_task -lpthread
+ *   ./bench_sensor_task [items] [seconds]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "sensor_task.h"
+#include "spsc_ring.h"
+
+#define SPEEDUP 20           // Virtual ms per real ms while the task runs
+#define STALL_EVERY_MS 3000  // Virtual time between consumer stalls ...
+#define STALL_MS 4000        // ... and their length (< SENSOR_QUEUE_LENGTH intervals)
+
+void setup() {}
+void loop() {}
+
+static float fixedPH() {
+    return 7.0f;
+}
+
+static bool testRing(uint32_t items) {
+    static SPSCRing<uint32_t, 64> ring;
+    uint32_t popped = 0;
+    uint32_t disorder = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&]() {
+        uint32_t value;
+        while (popped < items) {
+            if (ring.pop(value)) {
+                if (value != popped + 1) disorder++;
+                popped++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t retries = 0;
+    for (uint32_t i = 1; i <= items; i++) {
+        while (!ring.push(i)) {
+            retries++;   // Full - the consumer has not caught up yet
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    auto end = std::chrono::steady_clock::now();
+
+    bool ok = disorder == 0 && popped == items && ring.getDroppedCount() == retries;
+    printf("ring: %u items through %u slots, %u out of order, %u full pushes, %.1f ns/item  %s\n",
+           items, ring.capacity(), disorder, retries,
+           std::chrono::duration<double, std::nano>(end - start).count() / items,
+           ok ? "OK" : "FAIL");
+    return ok;
+}
+
+static bool testTask(uint32_t seconds) {
+    static DS18B20Sensor temperature(DS18B20_PIN);
+    static TurbiditySensor turbidity(TURBIDITY_SENSOR_PIN);
+    static SensorTask task;
+    NativeHW::setAnalogMilliVolts(TURBIDITY_SENSOR_PIN, 1800);
+    temperature.init();
+    turbidity.init();
+    task.begin(&temperature, &turbidity, fixedPH);
+
+    std::atomic<bool> running(true);
+    std::thread clock([&]() {
+        while (running) {
+            std::this_thread::sleep_for(std::chrono::microseconds(1000 / SPEEDUP));
+            NativeHW::advanceMillis(1);
+        }
+    });
+    task.startTask(0, SENSOR_TASK_PERIOD_MS);
+
+    uint32_t received = 0;
+    uint32_t gaps = 0;
+    uint32_t badSpacing = 0;
+    uint32_t lastSequence = 0;
+    unsigned long lastTimestamp = 0;
+    unsigned long nextStall = millis() + STALL_EVERY_MS;
+    unsigned long end = millis() + seconds * 1000UL;
+    while ((long)(millis() - end) < 0) {
+        SensorSnapshot snapshot;
+        while (task.poll(snapshot)) {
+            if (received > 0) {
+                if (snapshot.sequence != lastSequence + 1) gaps++;
+                if (snapshot.timestampMs - lastTimestamp > SENSOR_READ_INTERVAL + SENSOR_TASK_PERIOD_MS) badSpacing++;
+            }
+            lastSequence = snapshot.sequence;
+            lastTimestamp = snapshot.timestampMs;
+            received++;
+        }
+        if ((long)(millis() - nextStall) >= 0) {
+            // The consumer is busy (TLS handshake, LED frame, ...) - the task keeps sampling
+            std::this_thread::sleep_for(std::chrono::milliseconds(STALL_MS / SPEEDUP));
+            nextStall = millis() + STALL_EVERY_MS;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+
+    task.stopTask();
+    running = false;
+    clock.join();
+
+    SensorTaskStats stats = task.getStats();
+    bool ok = gaps == 0 && badSpacing == 0 && stats.dropped == 0 && received >= seconds - 1;
+    printf("task: %u s virtual at %dx, %u cycles, %u snapshots received, %u gaps, "
+           "%u late intervals, %u dropped, %u us worst wake-up delay  %s\n",
+           seconds, SPEEDUP, stats.cycles, received, gaps, badSpacing, stats.dropped,
+           stats.lateMaxUs, ok ? "OK" : "FAIL");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t items = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000000;
+    uint32_t seconds = argc > 2 ? strtoul(argv[2], nullptr, 10) : 30;
+    NativeHW::setSerialEcho(false);
+
+    bool ok = testRing(items);
+    ok = testTask(seconds) && ok;
+    return ok ? 0 : 1;
+}
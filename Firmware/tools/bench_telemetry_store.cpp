@@ -0,0 +1,181 @@
+/**
+ * @file bench_telemetry_store.cpp
+ * @brief Host test: TelemetryStore against the directory-backed LittleFS shim
+ *
+ * 1. Outage: records arrive once a second while the broker is down, spilling
+ *    from RAM into the segment log; replay starts, the device reboots halfway
+ *    through and replay continues from the saved cursor. Everything except
+ *    what was still in RAM at the reboot must come back once, in order.
+ * 2. Overflow: more records than TELEMETRY_LOG_MAX_SEGMENTS can hold. Whole
+ *    oldest segments are dropped; what is left is the newest, in order.
+ * 3. Full filesystem: LittleFS capacity far below the log bound. Writes come
+ *    up short, nothing is replayed twice or out of order and every record is
+ *    either replayed or counted as dropped.
+ * Reports microseconds per stored and per replayed record.
+ *
+ * Build & run (from the Firmware directory). ArduinoJson comes from the native
+ * environment's libdeps (pio pkg install -e native), with the flags native_shim's
+ * library.json normally adds:
+ *   g++ -std=gnu++17 -O2 -DNATIVE_NO_MAIN -DARDUINOJSON_ENABLE_ARDUINO_STRING=1 -DARDUINOJSON_ENABLE_PROGMEM=0 \
+ *       -Ilib/native_shim/src -I.pio/libdeps/native/ArduinoJson/src -Iinclude tools/bench_telemetry_store.cpp \
+ *       src/mqtt/telemetry_store.cpp src/mqtt/telemetry_batch.cpp src/sensors/sensor_snapshot.cpp \
+ *       $(find lib/native_shim/src -name '*.cpp') -o bench_telemetry_store -lpthread
+ *   ./bench_telemetry_store [records]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <LittleFS.h>
+#include <Preferences.h>
+#include "telemetry_store.h"
+
+void setup() {}
+void loop() {}
+
+typedef std::chrono::steady_clock Clock;
+
+// Fresh filesystem and NVS, like a newly flashed board
+static void wipe() {
+    LittleFS.begin(true);
+    LittleFS.format();
+    Preferences preferences;
+    preferences.begin("telemetry", false);
+    preferences.clear();
+    preferences.end();
+}
+
+static TelemetryRecord makeRecord(uint32_t sequence) {
+    TelemetryRecord record = {};
+    record.timestampMs = sequence;   // Identifies the record on the way back
+    record.samples = 1;
+    record.temperatureCount = 1;
+    record.temperature[0] = 25.0f;
+    return record;
+}
+
+// Replays everything; returns the timestamps in the order they came back
+static std::vector<uint32_t> replayAll(TelemetryStore& store, uint32_t limit, double* usPerRecord) {
+    std::vector<uint32_t> received;
+    TelemetryRecord batch[TELEMETRY_REPLAY_BATCH];
+    uint32_t boot;
+    auto start = Clock::now();
+    while (received.size() < limit) {
+        uint16_t count = store.peek(batch, TELEMETRY_REPLAY_BATCH, boot);
+        if (count == 0) break;
+        for (uint16_t i = 0; i < count; i++) received.push_back(batch[i].timestampMs);
+        store.consume(count);
+    }
+    if (usPerRecord) {
+        *usPerRecord = received.empty() ? 0 :
+            std::chrono::duration<double, std::micro>(Clock::now() - start).count() / received.size();
+    }
+    return received;
+}
+
+static bool inOrder(const std::vector<uint32_t>& values) {
+    for (size_t i = 1; i < values.size(); i++) {
+        if (values[i] <= values[i - 1]) return false;
+    }
+    return true;
+}
+
+static bool testOutage(uint32_t records) {
+    wipe();
+    TelemetryStore* store = new TelemetryStore();
+    store->begin();
+
+    auto start = Clock::now();
+    for (uint32_t i = 1; i <= records; i++) {
+        store->add(makeRecord(i));
+        NativeHW::advanceMillis(1000);
+        store->service(millis());
+    }
+    double addUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / records;
+    uint32_t segments = store->getSegmentCount();
+
+    // Half the backlog goes out, then the power drops
+    double replayUs = 0;
+    std::vector<uint32_t> received = replayAll(*store, records / 2, &replayUs);
+    uint32_t lostInRam = store->getRamCount();
+    TelemetryStoreStats before = store->getStats();
+    delete store;
+
+    store = new TelemetryStore();
+    store->begin();
+    std::vector<uint32_t> rest = replayAll(*store, records, nullptr);
+    received.insert(received.end(), rest.begin(), rest.end());
+    bool empty = !store->hasBacklog();
+    delete store;
+
+    bool ok = inOrder(received) && received.size() == records - lostInRam &&
+              received.front() == 1 && before.dropped == 0 && empty;
+    printf("outage: %u records, %u segments, %u replayed across a reboot, %u lost in RAM, "
+           "%.2f us/add %.2f us/replayed  %s\n",
+           records, segments, (uint32_t)received.size(), lostInRam, addUs, replayUs,
+           ok ? "OK" : "FAIL");
+    return ok;
+}
+
+static bool testOverflow() {
+    wipe();
+    TelemetryStore store;
+    store.begin();
+
+    const uint32_t bound = TELEMETRY_LOG_MAX_SEGMENTS * TELEMETRY_SEGMENT_RECORDS;
+    const uint32_t records = bound + TELEMETRY_SEGMENT_RECORDS * 3 + 100;
+    for (uint32_t i = 1; i <= records; i++) {
+        store.add(makeRecord(i));
+    }
+    std::vector<uint32_t> received = replayAll(store, records, nullptr);
+    TelemetryStoreStats stats = store.getStats();
+
+    bool ok = inOrder(received) && !received.empty() && received.back() == records &&
+              received.size() + stats.dropped == records && stats.dropped > 0 &&
+              stats.dropped % TELEMETRY_SEGMENT_RECORDS == 0 &&
+              store.getSegmentCount() <= TELEMETRY_LOG_MAX_SEGMENTS;
+    printf("overflow: %u records into %u segments of %u, %u replayed, %u dropped (oldest first)  %s\n",
+           records, TELEMETRY_LOG_MAX_SEGMENTS, TELEMETRY_SEGMENT_RECORDS,
+           (uint32_t)received.size(), stats.dropped, ok ? "OK" : "FAIL");
+    return ok;
+}
+
+static bool testFullFilesystem() {
+    wipe();
+    LittleFSFS::setCapacity(8 * 1024);
+    TelemetryStore store;
+    store.begin();
+
+    const uint32_t records = 2000;
+    for (uint32_t i = 1; i <= records; i++) {
+        store.add(makeRecord(i));
+    }
+    std::vector<uint32_t> received = replayAll(store, records, nullptr);
+    TelemetryStoreStats stats = store.getStats();
+    LittleFSFS::setCapacity(0x160000);
+
+    bool ok = inOrder(received) && received.size() + stats.dropped == records &&
+              stats.writeErrors > 0 && received.back() == records;
+    printf("full fs: %u records into 8 KB, %u replayed, %u dropped, %u short writes  %s\n",
+           records, (uint32_t)received.size(), stats.dropped, stats.writeErrors,
+           ok ? "OK" : "FAIL");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t records = argc > 1 ? strtoul(argv[1], nullptr, 10) : 3000;
+    if (records < 2) {
+        fprintf(stderr, "records must be at least 2\n");
+        return 1;
+    }
+    NativeHW::setSerialEcho(false);
+    static char root[] = "/tmp/telemetry_store_XXXXXX";
+    LittleFSFS::setHostRoot(mkdtemp(root));
+
+    bool ok = testOutage(records);
+    ok = testOverflow() && ok;
+    ok = testFullFilesystem() && ok;
+    return ok ? 0 : 1;
+}
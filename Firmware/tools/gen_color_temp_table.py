@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+Generate include/color_temp_table.h - black body colour temperature to RGB table.
+
+The table replaces the per-frame Planck evaluation that used to live in
+LEDController::colorTempToRGB(). It reproduces that math exactly:
+radiance sampled at 700/546/436 nm, normalised to the brightest channel,
+then a 1/2.2 gamma and truncation to 8 bits.
+
+The 1/2.2 step encodes the linear radiance ratios into the perceptual 0-255
+space every effect renders in; the output stage (gamma_table.h) decodes all
+colours to linear LED drive, so effects never apply output correction.
+
+Usage (from the Firmware directory):
+    python3 tools/gen_color_temp_table.py > include/color_temp_table.h
+"""
+
+import math
+
+# Physical constants for black body radiation (same values as the firmware used)
+H = 6.626e-34  # Planck's constant (J*s)
+C = 3.0e8      # Speed of light (m/s)
+K = 1.381e-23  # Boltzmann constant (J/K)
+
+LAMBDA_R = 700
+LAMBDA_G = 546
+LAMBDA_B = 436
+
+MIN_K = 0
+MAX_K = 6500
+STEP_K = 100
+
+
+def planck_radiance(lambda_nm, temp):
+    if temp <= 0:
+        return 0.0
+    lam = lambda_nm * 1e-9
+    exp_term = (H * C) / (lam * K * temp)
+    if exp_term > 50:
+        return 0.0
+    denominator = math.exp(exp_term) - 1.0
+    if denominator < 1e-10:
+        return 0.0
+    return 1.0 / (lam ** 5 * denominator)
+
+
+def color_temp_to_rgb(temp):
+    i = [planck_radiance(l, temp) for l in (LAMBDA_R, LAMBDA_G, LAMBDA_B)]
+    max_i = max(i)
+    if max_i <= 0:
+        return (0, 0, 0)  # Too cold to emit in the visible range
+    return tuple(int((v / max_i) ** (1.0 / 2.2) * 255) for v in i)
+
+
+def main():
+    entries = (MAX_K - MIN_K) // STEP_K + 1
+    print("/**")
+    print(" * @file color_temp_table.h")
+    print(" * @brief Precomputed black body colour temperature to RGB table")
+    print(" *")
+    print(" * GENERATED by tools/gen_color_temp_table.py - do not edit by hand.")
+    print(" */")
+    print()
+    print("#ifndef COLOR_TEMP_TABLE_H")
+    print("#define COLOR_TEMP_TABLE_H")
+    print()
+    print("#include <stdint.h>")
+    print()
+    print("#define COLOR_TEMP_TABLE_MIN_K %d" % MIN_K)
+    print("#define COLOR_TEMP_TABLE_MAX_K %d" % MAX_K)
+    print("#define COLOR_TEMP_TABLE_STEP_K %d" % STEP_K)
+    print("#define COLOR_TEMP_TABLE_SIZE %d" % entries)
+    print()
+    print("// {r, g, b} per entry, const so it stays in flash (.rodata)")
+    print("static const uint8_t COLOR_TEMP_TABLE[COLOR_TEMP_TABLE_SIZE][3] = {")
+    for n in range(entries):
+        temp = MIN_K + n * STEP_K
+        r, g, b = color_temp_to_rgb(temp)
+        print("    {%3d, %3d, %3d}, // %5d K" % (r, g, b, temp))
+    print("};")
+    print()
+    print("#endif // COLOR_TEMP_TABLE_H")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,41 @@
+#!/usr/bin/env python3
+"""
+Generate include/gamma_table.h - perceptual 8-bit value to linear LED drive.
+
+Effects work in a perceptual 0-255 space; WS2812 PWM is linear in light.
+The output stage (src/led/led_output_stage.cpp) maps every channel through
+this table. Entries are 8.8 fixed point so the fraction below one LED step
+survives until temporal dithering.
+
+Usage (from the Firmware directory):
+    python3 tools/gen_gamma_table.py > include/gamma_table.h
+"""
+
+GAMMA = 2.2
+
+
+def main():
+    print("/**")
+    print(" * @file gamma_table.h")
+    print(" * @brief Precomputed gamma %.1f table, 8-bit input to 8.8 fixed-point linear drive" % GAMMA)
+    print(" *")
+    print(" * GENERATED by tools/gen_gamma_table.py - do not edit by hand.")
+    print(" */")
+    print()
+    print("#ifndef GAMMA_TABLE_H")
+    print("#define GAMMA_TABLE_H")
+    print()
+    print("#include <stdint.h>")
+    print()
+    print("// 0..255 in 8.8 fixed point (65280 = 255.0), const so it stays in flash (.rodata)")
+    print("static const uint16_t GAMMA_TABLE[256] = {")
+    values = [int(round((i / 255.0) ** GAMMA * 255 * 256)) for i in range(256)]
+    for row in range(0, 256, 8):
+        print("    " + ", ".join("%5d" % v for v in values[row:row + 8]) + ",")
+    print("};")
+    print()
+    print("#endif // GAMMA_TABLE_H")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,317 @@
+/**
+ * @file led_recorder.cpp
+ * @brief Host tool: record LED effect frames and check them against golden hashes
+ *
+ * Runs effects from the registry on the virtual clock of the native shim with
+ * a fixed random seed and writes every frame plus its render time to a
+ * compact binary file (and optionally a PPM image, one row per frame). The
+ * wall clock the effects see is virtual too, so a full 24 h sky simulation
+ * day renders in seconds.
+ *
+ * Build (from the Firmware directory):
+ *   g++ -std=gnu++17 -O2 -DNATIVE_NO_MAIN -Ilib/native_shim/src -Iinclude \
+ *       tools/led_recorder.cpp src/led/led_effects.cpp src/led/highlight_renderer.cpp \
+ *       src/led/particle_system.cpp \
+ *       $(find lib/native_shim/src -name '*.cpp') -o led_recorder -lpthread
+ *
+ * Usage:
+ *   ./led_recorder [--mode NAME|all] [--seconds N] [--step-ms N] [--start HH:MM]
+ *                  [--seed N] [--leds N] [--out DIR] [--ppm]
+ *   ./led_recorder --check tools/golden/led_frames.txt      # exit 1 on mismatch
+ *   ./led_recorder --write-golden tools/golden/led_frames.txt
+ *
+ * .ledrec layout (little endian):
+ *   header: "LREC" | u16 version | u16 numLeds | u32 frameCount | u16 stepMs | char mode[16]
+ *   frame:  u32 tMs | u32 renderNs | numLeds * {r, g, b}
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "led_effects.h"
+
+#define RECORDER_FORMAT_VERSION 1
+#define DEFAULT_NUM_LEDS 60
+#define DEFAULT_EPOCH 1704067200   // 2024-01-01 00:00 UTC
+
+struct RecordOptions {
+    LEDMode mode = MODE_OFF;
+    uint32_t seconds = 10;
+    uint16_t stepMs = 0;           // 0 = the effect's own frame interval
+    uint32_t startMinute = 12 * 60;
+    uint32_t seed = 1;
+    int numLeds = DEFAULT_NUM_LEDS;
+};
+
+struct RecordResult {
+    uint32_t frames = 0;
+    uint32_t hash = 2166136261UL;  // FNV-1a over every frame
+    uint64_t totalRenderNs = 0;
+    uint32_t maxRenderNs = 0;
+};
+
+// ==================== Output Files ====================
+static void writeLE(FILE* f, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        fputc((value >> (8 * i)) & 0xFF, f);
+    }
+}
+
+static FILE* openRecording(const std::string& dir, const EffectInfo& info, const RecordOptions& opts,
+                           uint16_t stepMs) {
+    std::string path = dir + "/" + info.name + ".ledrec";
+    FILE* f = fopen(path.c_str(), "wb");
+    if (f == nullptr) {
+        fprintf(stderr, "Cannot write %s\n", path.c_str());
+        return nullptr;
+    }
+    char name[16] = {0};
+    strncpy(name, info.name, sizeof(name) - 1);
+    fwrite("LREC", 1, 4, f);
+    writeLE(f, RECORDER_FORMAT_VERSION, 2);
+    writeLE(f, opts.numLeds, 2);
+    writeLE(f, 0, 4);  // Frame count, patched when the run ends
+    writeLE(f, stepMs, 2);
+    fwrite(name, 1, sizeof(name), f);
+    return f;
+}
+
+static void writePPM(const std::string& dir, const EffectInfo& info, const std::vector<uint8_t>& pixels,
+                     int numLeds, uint32_t frames) {
+    std::string path = dir + "/" + info.name + ".ppm";
+    FILE* f = fopen(path.c_str(), "wb");
+    if (f == nullptr) {
+        fprintf(stderr, "Cannot write %s\n", path.c_str());
+        return;
+    }
+    fprintf(f, "P6\n%d %u\n255\n", numLeds, frames);
+    fwrite(pixels.data(), 1, pixels.size(), f);
+    fclose(f);
+}
+
+// ==================== Recording ====================
+static RecordResult record(const RecordOptions& opts, const std::string& outDir, bool ppm) {
+    const EffectInfo& info = getEffectInfo(opts.mode);
+    uint16_t stepMs = opts.stepMs ? opts.stepMs : info.frameIntervalMs;
+    uint32_t frameCount = (uint32_t)((uint64_t)opts.seconds * 1000 / stepMs);
+
+    // Every run starts from the same clock, seed and (black) framebuffer
+    NativeHW::setEpoch(DEFAULT_EPOCH + opts.startMinute * 60 - NativeHW::nowMicros() / 1000000);
+    std::vector<CRGB> leds(opts.numLeds);
+    EffectSlot slot;
+    slot.activate(info, opts.seed);
+
+    FILE* rec = outDir.empty() ? nullptr : openRecording(outDir, info, opts, stepMs);
+    std::vector<uint8_t> pixels;
+
+    RecordResult result;
+    EffectContext ctx;
+    ctx.leds = leds.data();
+    ctx.numLeds = opts.numLeds;
+    ctx.dtMs = stepMs;
+    ctx.customColor = CRGB(255, 80, 20);
+
+    for (uint32_t frame = 0; frame < frameCount; frame++) {
+        ctx.wallClock = NativeHW::wallClock();
+
+        auto start = std::chrono::steady_clock::now();
+        slot.render(ctx);
+        auto end = std::chrono::steady_clock::now();
+        uint32_t renderNs = (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        const uint8_t* bytes = (const uint8_t*)leds.data();
+        size_t frameBytes = opts.numLeds * sizeof(CRGB);
+        for (size_t i = 0; i < frameBytes; i++) {
+            result.hash = (result.hash ^ bytes[i]) * 16777619UL;
+        }
+        result.frames++;
+        result.totalRenderNs += renderNs;
+        if (renderNs > result.maxRenderNs) {
+            result.maxRenderNs = renderNs;
+        }
+
+        if (rec) {
+            writeLE(rec, frame * stepMs, 4);
+            writeLE(rec, renderNs, 4);
+            fwrite(bytes, 1, frameBytes, rec);
+        }
+        if (ppm) {
+            pixels.insert(pixels.end(), bytes, bytes + frameBytes);
+        }
+
+        delay(stepMs);
+    }
+
+    if (rec) {
+        fseek(rec, 8, SEEK_SET);
+        writeLE(rec, result.frames, 4);
+        fclose(rec);
+    }
+    if (ppm && !outDir.empty()) {
+        writePPM(outDir, info, pixels, opts.numLeds, result.frames);
+    }
+    return result;
+}
+
+static void printResult(const RecordOptions& opts, const RecordResult& result) {
+    printf("%-16s frames:%7u  render avg:%7.0f ns  max:%8u ns  hash:%08x\n",
+           getEffectInfo(opts.mode).name, result.frames,
+           result.frames ? (double)result.totalRenderNs / result.frames : 0.0,
+           result.maxRenderNs, result.hash);
+}
+
+// ==================== Golden Files ====================
+// One line per run: mode seconds stepMs startMinute seed numLeds frames hash
+
+static std::vector<RecordOptions> goldenRuns() {
+    std::vector<RecordOptions> runs;
+    for (int m = 0; m < LED_MODE_COUNT; m++) {
+        RecordOptions opts;
+        opts.mode = (LEDMode)m;
+        runs.push_back(opts);
+    }
+    // A whole sky simulation day, one frame per simulated minute
+    RecordOptions day;
+    day.mode = MODE_SKY_SIMULATION;
+    day.seconds = 24 * 3600;
+    day.stepMs = 60000;
+    day.startMinute = 0;
+    runs.push_back(day);
+    return runs;
+}
+
+static int writeGolden(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (f == nullptr) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 1;
+    }
+    fprintf(f, "# mode seconds step_ms start_minute seed leds frames hash - regenerate with led_recorder --write-golden\n");
+    for (const RecordOptions& opts : goldenRuns()) {
+        RecordResult result = record(opts, "", false);
+        printResult(opts, result);
+        fprintf(f, "%s %u %u %u %u %d %u %08x\n", getEffectInfo(opts.mode).name, opts.seconds, opts.stepMs,
+                opts.startMinute, opts.seed, opts.numLeds, result.frames, result.hash);
+    }
+    fclose(f);
+    return 0;
+}
+
+static int checkGolden(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) {
+        fprintf(stderr, "Cannot read %s\n", path);
+        return 1;
+    }
+    int failures = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        char name[32];
+        unsigned seconds, stepMs, startMinute, seed, frames, hash;
+        int numLeds;
+        if (sscanf(line, "%31s %u %u %u %u %d %u %x", name, &seconds, &stepMs, &startMinute, &seed,
+                   &numLeds, &frames, &hash) != 8) {
+            fprintf(stderr, "Malformed golden line: %s", line);
+            failures++;
+            continue;
+        }
+        const EffectInfo* info = findEffectByName(name);
+        if (info == nullptr) {
+            fprintf(stderr, "Unknown mode in golden file: %s\n", name);
+            failures++;
+            continue;
+        }
+        RecordOptions opts;
+        opts.mode = info->mode;
+        opts.seconds = seconds;
+        opts.stepMs = stepMs;
+        opts.startMinute = startMinute;
+        opts.seed = seed;
+        opts.numLeds = numLeds;
+        RecordResult result = record(opts, "", false);
+        printResult(opts, result);
+        if (result.frames != frames || result.hash != hash) {
+            printf("  MISMATCH: expected frames:%u hash:%08x\n", frames, hash);
+            failures++;
+        }
+    }
+    fclose(f);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
+
+// ==================== Main ====================
+int main(int argc, char** argv) {
+    // Effects read local time - keep host runs independent of the machine's zone
+    setenv("TZ", "UTC", 1);
+    tzset();
+    NativeHW::setSerialEcho(false);
+
+    RecordOptions opts;
+    bool allModes = true;
+    bool ppm = false;
+    std::string outDir;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--check") == 0 && hasValue) {
+            return checkGolden(argv[++i]);
+        } else if (strcmp(argv[i], "--write-golden") == 0 && hasValue) {
+            return writeGolden(argv[++i]);
+        } else if (strcmp(argv[i], "--mode") == 0 && hasValue) {
+            const char* name = argv[++i];
+            if (strcmp(name, "all") != 0) {
+                const EffectInfo* info = findEffectByName(name);
+                if (info == nullptr) {
+                    fprintf(stderr, "Unknown mode: %s\n", name);
+                    return 1;
+                }
+                opts.mode = info->mode;
+                allModes = false;
+            }
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            opts.seconds = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--step-ms") == 0 && hasValue) {
+            opts.stepMs = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--start") == 0 && hasValue) {
+            unsigned hours = 0, minutes = 0;
+            sscanf(argv[++i], "%u:%u", &hours, &minutes);
+            opts.startMinute = (hours % 24) * 60 + minutes % 60;
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            opts.seed = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--leds") == 0 && hasValue) {
+            opts.numLeds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--out") == 0 && hasValue) {
+            outDir = argv[++i];
+        } else if (strcmp(argv[i], "--ppm") == 0) {
+            ppm = true;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (opts.numLeds <= 0) {
+        fprintf(stderr, "--leds must be positive\n");
+        return 1;
+    }
+
+    for (int m = 0; m < LED_MODE_COUNT; m++) {
+        if (!allModes && m != opts.mode) {
+            continue;
+        }
+        RecordOptions run = opts;
+        run.mode = (LEDMode)m;
+        printResult(run, record(run, outDir, ppm));
+    }
+    return 0;
+}